@@ -0,0 +1,223 @@
+#pragma once
+#include "Table.h"
+#include "Workload.h"
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+
+// every benchmark is a function registered by BENCHMARK(name) { ... }
+// bench_data_structures [filter] [--json file] [--max-size n] runs benchmarks whose names contain filter,
+// results are printed and saved to the JSON file
+struct Benchmark {
+    std::string name;
+    void (*function)();
+};
+
+inline std::vector<Benchmark>& getBenchmarks() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+struct BenchmarkRegistrar {
+    BenchmarkRegistrar(const char* name, void (*function)()) {
+        getBenchmarks().push_back({ name, function });
+    }
+};
+
+// options from the command line
+struct BenchmarkOptions {
+    std::string jsonPath;          // results are not saved if it is empty
+    size_t maxSize = 1000000;      // maximal number of elements in tables of workload benchmarks
+};
+
+inline BenchmarkOptions& getBenchmarkOptions() {
+    static BenchmarkOptions options;
+    return options;
+}
+
+// result of one measurement, it is saved to JSON
+struct BenchmarkRecord {
+    std::string benchmark;  // name of BENCHMARK, it is set by the runner
+    std::string name;
+    std::string table;
+    std::vector<std::pair<std::string, double>> metrics;
+};
+
+inline std::vector<BenchmarkRecord>& getBenchmarkRecords() {
+    static std::vector<BenchmarkRecord> records;
+    return records;
+}
+
+inline std::string escapeJson(const std::string& str) {
+    std::string res;
+    for (char c : str) {
+        if (c == '"' || c == '\\') res += '\\';
+        res += c;
+    }
+    return res;
+}
+
+// returns false if file can't be opened
+inline bool saveBenchmarkRecords(const std::string& path) {
+    std::ofstream file(path);
+    if (!file) return false;
+    file << "[\n";
+    const std::vector<BenchmarkRecord>& records = getBenchmarkRecords();
+    for (size_t i = 0; i < records.size(); i++) {
+        file << "  {\"benchmark\": \"" << escapeJson(records[i].benchmark)
+            << "\", \"name\": \"" << escapeJson(records[i].name)
+            << "\", \"table\": \"" << escapeJson(records[i].table) << "\"";
+        for (const std::pair<std::string, double>& metric : records[i].metrics)
+            file << ", \"" << escapeJson(metric.first) << "\": " << metric.second;
+        file << (i + 1 < records.size() ? "},\n" : "}\n");
+    }
+    file << "]\n";
+    return bool(file);
+}
+
+#define BENCHMARK(name)                                                              \
+static void bench##name();                                                           \
+static BenchmarkRegistrar registrar##name(#name, bench##name);                       \
+static void bench##name()
+
+
+class Timer {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+public:
+
+    double getElapsedNs() const {
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+// keeps the compiler from throwing away results of measured code
+template <class T>
+void doNotOptimize(const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile char sink;
+    sink = *reinterpret_cast<const volatile char*>(&value);
+#endif
+}
+
+inline void printResult(const std::string& benchmark, const std::string& table, double nsPerOp) {
+    std::printf("%-32s %-28s %10.1f ns/op\n", benchmark.c_str(), table.c_str(), nsPerOp);
+    getBenchmarkRecords().push_back({ "", benchmark, table, { { "ns_per_op", nsPerOp } } });
+}
+
+
+// latencies are reordered
+inline LatencySummary getLatencySummary(std::vector<double>& latencies) {
+    LatencySummary summary;
+    if (latencies.empty()) return summary;
+    auto percentile = [&latencies](double p) {
+        auto it = latencies.begin() + size_t(p * (latencies.size() - 1));
+        std::nth_element(latencies.begin(), it, latencies.end());
+        return *it;
+    };
+    summary.p50 = percentile(0.5);
+    summary.p90 = percentile(0.9);
+    summary.p99 = percentile(0.99);
+    summary.p999 = percentile(0.999);
+    summary.max = *std::max_element(latencies.begin(), latencies.end());
+    return summary;
+}
+
+
+// resident set size of the process, MB, 0 if it is unknown
+inline double getCurrentRssMb() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return double(counters.WorkingSetSize) / (1 << 20);
+#elif defined(__linux__)
+    long pages = 0, residentPages = 0;
+    FILE* file = std::fopen("/proc/self/statm", "r");
+    if (!file) return 0;
+    int read = std::fscanf(file, "%ld %ld", &pages, &residentPages);
+    std::fclose(file);
+    if (read != 2) return 0;
+    return double(residentPages) * double(sysconf(_SC_PAGESIZE)) / (1 << 20);
+#else
+    return 0;
+#endif
+}
+
+// maximal resident set size of the process since its start, MB
+inline double getPeakRssMb() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return double(counters.PeakWorkingSetSize) / (1 << 20);
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return double(usage.ru_maxrss) / (1 << 20);  // bytes
+#else
+    return double(usage.ru_maxrss) / (1 << 10);  // KB
+#endif
+#endif
+}
+
+
+enum class KeyDistribution { DENSE, SPARSE, CLUSTERED };
+
+inline const char* getName(KeyDistribution distribution) {
+    switch (distribution) {
+    case KeyDistribution::DENSE: return "dense";
+    case KeyDistribution::SPARSE: return "sparse";
+    default: return "clustered";
+    }
+}
+
+// dense: permutation of 0..n-1
+// sparse: uniformly distributed over the whole range of KeyType
+// clustered: runs of 64 consecutive keys starting from random points
+// all keys are unique, order is random
+inline std::vector<KeyType> generateKeys(KeyDistribution distribution, size_t n, uint32_t seed = 1) {
+    std::mt19937 gen(seed);
+    std::vector<KeyType> keys;
+    keys.reserve(n);
+    switch (distribution) {
+    case KeyDistribution::DENSE:
+        for (size_t i = 0; i < n; i++) keys.push_back(KeyType(i));
+        break;
+    case KeyDistribution::SPARSE:
+        while (keys.size() < n) keys.push_back(KeyType(gen()));
+        break;
+    case KeyDistribution::CLUSTERED:
+        while (keys.size() < n) {
+            KeyType base = KeyType(gen()) & ~KeyType(63);
+            for (KeyType i = 0; i < 64 && keys.size() < n; i++) keys.push_back(base + i);
+        }
+        break;
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    while (keys.size() < n) keys.push_back(keys.back() + 1);  // collisions of random keys
+    std::shuffle(keys.begin(), keys.end(), gen);
+    return keys;
+}
+
+
@@ -0,0 +1,45 @@
+#include "AdaptiveRadixTree.h"
+#include "OrderedTable.h"
+#include "HashTableOpenAddressing.h"
+
+#include "bench.h"
+
+
+// insertion, successful search and erasing of n keys
+template <class TableType>
+void benchmarkTable(const std::string& tableName, KeyDistribution distribution, size_t n) {
+    std::vector<KeyType> keys = generateKeys(distribution, n);
+    std::vector<KeyType> searchKeys = keys;
+    std::shuffle(searchKeys.begin(), searchKeys.end(), std::mt19937(2));
+    std::string prefix = std::string(getName(distribution)) + " n=" + std::to_string(n) + " ";
+    TableType table;
+
+    Timer insertTimer;
+    for (KeyType key : keys)
+        table.insert(key, int(key));
+    printResult(prefix + "insert", tableName, insertTimer.getElapsedNs() / n);
+
+    Timer findTimer;
+    for (KeyType key : searchKeys)
+        doNotOptimize(table.find(key));
+    printResult(prefix + "find", tableName, findTimer.getElapsedNs() / n);
+
+    Timer eraseTimer;
+    for (KeyType key : searchKeys)
+        table.erase(key);
+    printResult(prefix + "erase", tableName, eraseTimer.getElapsedNs() / n);
+}
+
+BENCHMARK(AdaptiveRadixTree) {
+    const size_t n = size_t(1) << 20;
+    const size_t nOrdered = size_t(1) << 16;  // insertion into OrderedTable is O(n)
+    KeyDistribution distributions[] = {
+        KeyDistribution::DENSE, KeyDistribution::SPARSE, KeyDistribution::CLUSTERED
+    };
+    for (KeyDistribution distribution : distributions) {
+        benchmarkTable<AdaptiveRadixTree<int>>("AdaptiveRadixTree", distribution, n);
+        benchmarkTable<HashTableOpenAddressing<int>>("HashTableOpenAddressing", distribution, n);
+        benchmarkTable<AdaptiveRadixTree<int>>("AdaptiveRadixTree", distribution, nOrdered);
+        benchmarkTable<OrderedTable<int>>("OrderedTable", distribution, nOrdered);
+    }
+}
@@ -0,0 +1,76 @@
+#include "UnorderedTable.h"
+#include "OrderedTable.h"
+#include "HashTableOpenAddressing.h"
+#include "HashTableSeparateChaining.h"
+#include "AdaptiveRadixTree.h"
+#include "DirectAddressTable.h"
+
+#include "bench.h"
+
+
+// the same generic code is called with a table type and with TableInterface
+template <class TableType>
+size_t countFound(TableType& table, const std::vector<KeyType>& keys) {
+    size_t count = 0;
+    for (KeyType key : keys)
+        count += table.find(key) != nullptr;
+    return count;
+}
+
+template <class TableType>
+size_t countEvents(TableType& table, const std::vector<KeyType>& keys) {
+    for (KeyType key : keys)
+        table.update(key, [](int& count) { count++; });
+    return table.getSize();
+}
+
+// calls of functions of the table type vs virtual calls through TableInterface
+template <class TableType>
+void benchmarkDevirtualization(const std::string& tableName, size_t n) {
+    const size_t searches = size_t(1) << 22;
+    std::vector<KeyType> keys = generateKeys(KeyDistribution::DENSE, 2 * n);
+    std::vector<KeyType> searchKeys(searches), updateKeys(searches);
+    std::mt19937 gen(4);
+    for (KeyType& key : searchKeys)
+        key = keys[gen() % (2 * n)];  // half of keys are absent
+    for (KeyType& key : updateKeys)
+        key = keys[gen() % n];  // elements are not inserted, so both runs do the same work
+
+    TableAdapter<TableType> adapter;
+    for (size_t i = 0; i < n; i++)
+        adapter.getTable().insert(keys[i], int(i));
+    // the compiler can't know the dynamic type of the table
+    TableInterface<int>* volatile interfacePtr = &adapter;
+    TableInterface<int>& tableInterface = *interfacePtr;
+    const std::string suffix = " n=" + std::to_string(n);
+    doNotOptimize(countFound(adapter.getTable(), searchKeys));  // warm up
+
+    Timer staticTimer;
+    doNotOptimize(countFound(adapter.getTable(), searchKeys));
+    printResult("find static" + suffix, tableName, staticTimer.getElapsedNs() / searches);
+
+    Timer virtualTimer;
+    doNotOptimize(countFound(tableInterface, searchKeys));
+    printResult("find virtual" + suffix, tableName, virtualTimer.getElapsedNs() / searches);
+
+    Timer staticUpdateTimer;
+    doNotOptimize(countEvents(adapter.getTable(), updateKeys));
+    printResult("update static" + suffix, tableName, staticUpdateTimer.getElapsedNs() / searches);
+
+    Timer virtualUpdateTimer;
+    doNotOptimize(countEvents(tableInterface, updateKeys));
+    printResult("update virtual" + suffix, tableName, virtualUpdateTimer.getElapsedNs() / searches);
+}
+
+BENCHMARK(Devirtualization) {
+    for (size_t n : { size_t(1) << 6, size_t(1) << 16 }) {
+        if (n <= 1024) {
+            benchmarkDevirtualization<UnorderedTable<int>>("UnorderedTable", n);
+            benchmarkDevirtualization<OrderedTable<int>>("OrderedTable", n);
+        }
+        benchmarkDevirtualization<HashTableOpenAddressing<int>>("HashTableOpenAddressing", n);
+        benchmarkDevirtualization<HashTableSeparateChaining<int>>("HashTableSeparateChaining", n);
+        benchmarkDevirtualization<AdaptiveRadixTree<int>>("AdaptiveRadixTree", n);
+        benchmarkDevirtualization<DirectAddressTable<int>>("DirectAddressTable", n);
+    }
+}
@@ -0,0 +1,131 @@
+#include "HashTableSeparateChaining.h"
+#include "HashTableOpenAddressing.h"
+#include "Intrinsics.h"
+
+#include "bench.h"
+
+
+// storage size of a table with fixed load, it is a power of 2
+// the number of elements doesn't exceed the max size of benchmarks
+size_t getPolicyBenchmarkStorageSize(double maxLoadFactor) {
+    size_t storageSize = 1024;
+    while (2 * storageSize * maxLoadFactor <= getBenchmarkOptions().maxSize)
+        storageSize *= 2;
+    return storageSize;
+}
+
+// the table is filled up to the max load factor without repacks,
+// then successful and unsuccessful searches are measured, memory is given per element
+template <class TableType>
+void benchmarkLoadFactor(const std::string& tableName, double maxLoadFactor) {
+    const size_t searches = size_t(1) << 22;
+    const size_t storageSize = getPolicyBenchmarkStorageSize(maxLoadFactor);
+    const size_t n = size_t(maxLoadFactor * storageSize);
+    std::vector<KeyType> keys = generateKeys(KeyDistribution::SPARSE, 2 * n);
+    std::vector<KeyType> hitKeys(searches), missKeys(searches);
+    std::mt19937 gen(3);
+    for (size_t i = 0; i < searches; i++) {
+        hitKeys[i] = keys[gen() % n];
+        missKeys[i] = keys[n + gen() % n];
+    }
+
+    HashTablePolicy policy;
+    policy.maxLoadFactor = maxLoadFactor;
+    policy.startStorageSizeDeg = getHighestBitIndex(storageSize);
+    TableType table(policy);
+    Timer insertTimer;
+    for (size_t i = 0; i < n; i++)
+        table.insert(keys[i], int(i));
+    double insertNs = insertTimer.getElapsedNs() / n;
+
+    Timer hitTimer;
+    for (KeyType key : hitKeys)
+        doNotOptimize(table.find(key));
+    double hitNs = hitTimer.getElapsedNs() / searches;
+    Timer missTimer;
+    for (KeyType key : missKeys)
+        doNotOptimize(table.find(key));
+    double missNs = missTimer.getElapsedNs() / searches;
+    double bytesPerElement = double(table.getMemoryUsage().getTotal()) / n;
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "load %.2f n=%zu", maxLoadFactor, n);
+    std::printf("%-32s %-28s insert %6.1f  hit %6.1f  miss %6.1f ns  %6.1f bytes/elem\n",
+        name, tableName.c_str(), insertNs, hitNs, missNs, bytesPerElement);
+    getBenchmarkRecords().push_back({ "", name, tableName, {
+        { "max_load_factor", maxLoadFactor }, { "insert_ns", insertNs }, { "find_hit_ns", hitNs },
+        { "find_miss_ns", missNs }, { "bytes_per_element", bytesPerElement } } });
+}
+
+// memory and speed of searches for different max load factors
+BENCHMARK(LoadFactor) {
+    for (double maxLoadFactor : { 0.5, 0.6, 0.7, 0.8, 0.9 })
+        benchmarkLoadFactor<HashTableOpenAddressing<int>>("OpenAddressing", maxLoadFactor);
+    for (double maxLoadFactor : { 0.5, 0.7, 1.0, 2.0, 4.0 })
+        benchmarkLoadFactor<HashTableSeparateChaining<int>>("Chaining<List>", maxLoadFactor);
+}
+
+
+// filling from the start size, the time includes repacks
+template <class TableType>
+void benchmarkGrowth(const std::string& tableName, size_t growthDeg, size_t n) {
+    std::vector<KeyType> keys = generateKeys(KeyDistribution::SPARSE, n);
+    HashTablePolicy policy;
+    policy.growthDeg = growthDeg;
+
+    TableType table(policy);
+    Timer timer;
+    for (size_t i = 0; i < n; i++)
+        table.insert(keys[i], int(i));
+    double insertNs = timer.getElapsedNs() / n;
+    double bytesPerElement = double(table.getMemoryUsage().getTotal()) / n;
+
+    std::string name = "growth x" + std::to_string(size_t(1) << growthDeg) + " n=" + std::to_string(n);
+    std::printf("%-32s %-28s insert %6.1f ns  %6.1f bytes/elem\n",
+        name.c_str(), tableName.c_str(), insertNs, bytesPerElement);
+    getBenchmarkRecords().push_back({ "", name, tableName, {
+        { "insert_ns", insertNs }, { "bytes_per_element", bytesPerElement } } });
+}
+
+BENCHMARK(GrowthFactor) {
+    const size_t n = std::min<size_t>(getBenchmarkOptions().maxSize, 1000000);
+    for (size_t growthDeg : { 1, 2, 3 }) {
+        benchmarkGrowth<HashTableOpenAddressing<int>>("OpenAddressing", growthDeg, n);
+        benchmarkGrowth<HashTableSeparateChaining<int>>("Chaining<List>", growthDeg, n);
+    }
+}
+
+
+// erasing and inserting of keys with a constant size of the table,
+// deleted cells make unsuccessful searches longer until they are dropped by rehash
+// factors are not greater than 1 - max load factor, so that empty cells are always left
+BENCHMARK(TombstoneFactor) {
+    const size_t n = std::min<size_t>(getBenchmarkOptions().maxSize, 1 << 18);
+    const size_t operations = size_t(1) << 21;
+    std::vector<KeyType> keys = generateKeys(KeyDistribution::SPARSE, n + operations);
+
+    for (double maxTombstoneFactor : { 0.02, 0.05, 0.1, 0.2, 0.3 }) {
+        HashTablePolicy policy;
+        policy.maxTombstoneFactor = maxTombstoneFactor;
+        HashTableOpenAddressing<int, std::pair<KeyType, int>, HashTableStatisticsCollector> table(policy);
+        for (size_t i = 0; i < n; i++)
+            table.insert(keys[i], int(i));
+
+        Timer timer;
+        for (size_t i = 0; i < operations; i++) {
+            table.erase(keys[i]);
+            table.insert(keys[n + i], int(i));
+            doNotOptimize(table.find(keys[i]));
+        }
+        double ns = timer.getElapsedNs() / operations;
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "tombstones %.2f n=%zu", maxTombstoneFactor, n);
+        HashTableStatistics statistics = table.getStatistics();
+        std::printf("%-32s %-28s erase+insert+miss %7.1f ns  repacks %zu\n",
+            name, "OpenAddressing", ns, statistics.repackCount);
+        getBenchmarkRecords().push_back({ "", name, "OpenAddressing", {
+            { "max_tombstone_factor", maxTombstoneFactor }, { "ns_per_op", ns },
+            { "repacks", double(statistics.repackCount) } } });
+    }
+}
@@ -0,0 +1,46 @@
+#include "HashTableSeparateChaining.h"
+#include "HashTableOpenAddressing.h"
+
+#include "bench.h"
+
+
+// filling of a table, then successful and unsuccessful search
+template <class TableType>
+void benchmarkBucketType(const std::string& tableName, size_t n) {
+    const size_t searches = size_t(1) << 22;
+    std::vector<KeyType> keys = generateKeys(KeyDistribution::SPARSE, 2 * n);
+    std::vector<KeyType> searchKeys(searches);
+    std::mt19937 gen(2);
+    for (KeyType& key : searchKeys)
+        key = keys[gen() % (2 * n)];  // half of keys are absent
+
+    TableType table;
+    Timer insertTimer;  // includes repacks
+    for (size_t i = 0; i < n; i++)
+        table.insert(keys[i], int(i));
+    printResult("insert n=" + std::to_string(n), tableName, insertTimer.getElapsedNs() / n);
+
+    Timer timer;
+    for (KeyType key : searchKeys)
+        doNotOptimize(table.find(key));
+    printResult("find n=" + std::to_string(n), tableName, timer.getElapsedNs() / searches);
+}
+
+BENCHMARK(SeparateChainingBuckets) {
+    using Pair = std::pair<KeyType, int>;
+    for (size_t n : { size_t(1) << 10, size_t(1) << 16, size_t(1) << 20 }) {
+        benchmarkBucketType<HashTableSeparateChaining<int>>("Chaining<List>", n);
+        benchmarkBucketType<HashTableSeparateChaining<int, UnrolledList<Pair>>>("Chaining<UnrolledList>", n);
+        benchmarkBucketType<HashTableSeparateChaining<int, SmallVectorBucket<Pair>>>("Chaining<SmallVectorBucket>", n);
+    }
+}
+
+// tables with hashes of keys kept in cells
+BENCHMARK(CachedHash) {
+    for (size_t n : { size_t(1) << 10, size_t(1) << 16, size_t(1) << 20 }) {
+        benchmarkBucketType<HashTableOpenAddressing<int>>("OpenAddressing", n);
+        benchmarkBucketType<HashTableOpenAddressing<int, HashedPair<int>>>("OpenAddressing<HashedPair>", n);
+        benchmarkBucketType<HashTableSeparateChaining<int>>("Chaining<List>", n);
+        benchmarkBucketType<HashTableSeparateChaining<int, List<HashedPair<int>>>>("Chaining<List<HashedPair>>", n);
+    }
+}
@@ -0,0 +1,46 @@
+#include "HashTableSeparateChaining.h"
+#include "IntrusiveHashTable.h"
+
+#include "bench.h"
+
+
+struct BenchRecord : public IntrusiveListHook<BenchRecord> {
+    KeyType key;
+    int value;
+};
+
+// objects are owned by the caller, tables only index them by key
+BENCHMARK(IntrusiveHashTable) {
+    for (size_t n : { size_t(1) << 10, size_t(1) << 16, size_t(1) << 20 }) {
+        std::vector<KeyType> keys = generateKeys(KeyDistribution::SPARSE, n);
+        std::vector<BenchRecord> records(n);
+        for (size_t i = 0; i < n; i++) {
+            records[i].key = keys[i];
+            records[i].value = int(i);
+        }
+        const std::string sizeName = " n=" + std::to_string(n);
+
+        {
+            HashTableSeparateChaining<BenchRecord*> table;
+            Timer insertTimer;
+            for (BenchRecord& record : records)
+                table.insert(record.key, &record);
+            printResult("insert" + sizeName, "SeparateChaining<T*>", insertTimer.getElapsedNs() / n);
+            Timer eraseTimer;
+            for (KeyType key : keys)
+                table.erase(key);
+            printResult("erase" + sizeName, "SeparateChaining<T*>", eraseTimer.getElapsedNs() / n);
+        }
+        {
+            IntrusiveHashTable<BenchRecord, MemberKey<BenchRecord, &BenchRecord::key>> table;
+            Timer insertTimer;
+            for (BenchRecord& record : records)
+                table.insert(record);
+            printResult("insert" + sizeName, "IntrusiveHashTable", insertTimer.getElapsedNs() / n);
+            Timer eraseTimer;
+            for (KeyType key : keys)
+                table.erase(key);
+            printResult("erase" + sizeName, "IntrusiveHashTable", eraseTimer.getElapsedNs() / n);
+        }
+    }
+}
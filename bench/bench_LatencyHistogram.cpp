@@ -0,0 +1,56 @@
+#include "HashTableOpenAddressing.h"
+#include "HashTableSeparateChaining.h"
+#include "LatencyHistogram.h"
+
+#include "bench.h"
+
+
+template <class TableType>
+size_t countFoundKeys(TableType& table, const std::vector<KeyType>& keys) {
+    size_t count = 0;
+    for (KeyType key : keys)
+        count += table.find(key) != nullptr;
+    return count;
+}
+
+// overhead of InstrumentedTable on searches and latencies of insertions
+// repacks are seen only in the tail of insertion latencies
+template <class TableType>
+void benchmarkInstrumentedTable(const std::string& tableName, size_t n) {
+    const size_t searches = size_t(1) << 22;
+    std::vector<KeyType> keys = generateKeys(KeyDistribution::SPARSE, n);
+    std::vector<KeyType> searchKeys(searches);
+    std::mt19937 gen(8);
+    for (KeyType& key : searchKeys)
+        key = keys[gen() % n];
+    const std::string suffix = " n=" + std::to_string(n);
+
+    InstrumentedTable<TableType> table;
+    for (KeyType key : keys)
+        table.insert(key, int(key));
+    LatencySummary insertions = table.getLatencies(TableOperation::INSERT).getSummary();
+    std::printf("%-32s %-28s p50 %7.1f  p99 %8.1f  p99.9 %8.1f  max %10.1f ns\n", ("insert" + suffix).c_str(),
+        tableName.c_str(), insertions.p50, insertions.p99, insertions.p999, insertions.max);
+    getBenchmarkRecords().push_back({ "", "insert" + suffix, tableName, {
+        { "p50_ns", insertions.p50 }, { "p90_ns", insertions.p90 }, { "p99_ns", insertions.p99 },
+        { "p999_ns", insertions.p999 }, { "max_ns", insertions.max } } });
+    doNotOptimize(countFoundKeys(table.getTable(), searchKeys));  // warm up
+
+    Timer plainTimer;
+    doNotOptimize(countFoundKeys(table.getTable(), searchKeys));
+    printResult("find plain" + suffix, tableName, plainTimer.getElapsedNs() / searches);
+
+    for (size_t period : { 1, 16, 256 }) {
+        table.setSamplingPeriod(period);
+        Timer timer;
+        doNotOptimize(countFoundKeys(table, searchKeys));
+        printResult("find sampled 1/" + std::to_string(period) + suffix, tableName, timer.getElapsedNs() / searches);
+    }
+}
+
+BENCHMARK(InstrumentedTable) {
+    for (size_t n : { size_t(1000), std::min<size_t>(getBenchmarkOptions().maxSize, 1000000) }) {
+        benchmarkInstrumentedTable<HashTableOpenAddressing<int>>("HashTableOpenAddressing", n);
+        benchmarkInstrumentedTable<HashTableSeparateChaining<int>>("HashTableSeparateChaining", n);
+    }
+}
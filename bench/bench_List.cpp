@@ -0,0 +1,97 @@
+#include "List.h"
+#include "UnrolledList.h"
+
+#include "bench.h"
+
+
+// pushFront of n elements to buckets lists chosen at random, then clear
+template <class ListType>
+void benchmarkBuckets(const std::string& listName, size_t buckets, size_t n) {
+    std::vector<size_t> bucketIndices(n);
+    std::mt19937 gen(1);
+    for (size_t& index : bucketIndices)
+        index = gen() % buckets;
+    std::vector<ListType> lists(buckets, ListType(typename ListType::allocator_type()));
+
+    Timer pushTimer;
+    for (size_t i = 0; i < n; i++)
+        lists[bucketIndices[i]].pushFront(int(i));
+    printResult("pushFront buckets=" + std::to_string(buckets), listName, pushTimer.getElapsedNs() / n);
+
+    Timer walkTimer;
+    size_t sum = 0;
+    for (ListType& list : lists)
+        for (auto ptr = list.getFirst(); ptr; ptr = ptr->next)
+            sum += ptr->data;
+    doNotOptimize(sum);
+    printResult("walk buckets=" + std::to_string(buckets), listName, walkTimer.getElapsedNs() / n);
+
+    Timer clearTimer;
+    for (ListType& list : lists)
+        list.clear();
+    printResult("clear buckets=" + std::to_string(buckets), listName, clearTimer.getElapsedNs() / n);
+}
+
+BENCHMARK(ListAllocator) {
+    const size_t n = size_t(1) << 22;
+    for (size_t buckets : { size_t(1), size_t(1) << 20 }) {
+        benchmarkBuckets<List<int, std::allocator<int>>>("List<std::allocator>", buckets, n);
+        benchmarkBuckets<List<int>>("List<PoolAllocator>", buckets, n);
+    }
+}
+
+// search of absent key in one chain, as in a bucket of an overloaded hash table
+template <class ListType>
+void benchmarkChainScan(const std::string& listName, size_t n) {
+    ListType list;
+    for (size_t i = 0; i < n; i++)
+        list.pushFront(std::make_pair(KeyType(i), int(i)));
+
+    const size_t repeats = std::max<size_t>(1, (size_t(1) << 22) / n);
+    Timer timer;
+    size_t found = 0;
+    for (size_t r = 0; r < repeats; r++) {
+        KeyType key = KeyType(n + r);
+        found += list.findFirst([key](const std::pair<KeyType, int>& cell) { return cell.first == key; }) != nullptr;
+    }
+    doNotOptimize(found);
+    printResult("chain scan n=" + std::to_string(n), listName, timer.getElapsedNs() / (repeats * n));
+}
+
+BENCHMARK(UnrolledListScan) {
+    for (size_t n : { size_t(4), size_t(16), size_t(256), size_t(1) << 16 }) {
+        benchmarkChainScan<List<std::pair<KeyType, int>>>("List", n);
+        benchmarkChainScan<UnrolledList<std::pair<KeyType, int>>>("UnrolledList", n);
+    }
+}
+
+// sorting of a list with random keys, the list is rebuilt before every run
+BENCHMARK(ListSort) {
+    for (size_t n : { size_t(1) << 12, size_t(1) << 16, size_t(1) << 20 }) {
+        std::vector<KeyType> keys = generateKeys(KeyDistribution::SPARSE, n);
+        List<KeyType> list;
+        for (KeyType key : keys) list.pushBack(key);
+        const std::string sizeName = " n=" + std::to_string(n);
+
+        Timer sortTimer;
+        list.sort();
+        printResult("sort" + sizeName, "List::sort", sortTimer.getElapsedNs() / n);
+
+        list.clear();
+        for (KeyType key : keys) list.pushBack(key);
+        Timer parallelTimer;
+        list.parallelSort();
+        printResult("sort" + sizeName, "List::parallelSort", parallelTimer.getElapsedNs() / n);
+
+        // copying to a vector and back doubles memory
+        list.clear();
+        for (KeyType key : keys) list.pushBack(key);
+        Timer vectorTimer;
+        std::vector<KeyType> elements(list.begin(), list.end());
+        std::stable_sort(elements.begin(), elements.end());
+        auto it = list.begin();
+        for (KeyType key : elements) *(it++) = key;
+        printResult("sort" + sizeName, "std::stable_sort copy", vectorTimer.getElapsedNs() / n);
+        doNotOptimize(list.getFirst()->data);
+    }
+}
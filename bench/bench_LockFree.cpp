@@ -0,0 +1,69 @@
+#include "List.h"
+#include "LockFreeQueue.h"
+#include "LockFreeStack.h"
+
+#include "bench.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+
+// List guarded by a mutex, as it is used for handoff between threads
+template <class T>
+class MutexQueue {
+    std::mutex mutex;
+    List<T, std::allocator<T>> list;
+
+public:
+
+    void push(const T& data) {
+        std::lock_guard<std::mutex> lock(mutex);
+        list.pushBack(data);
+    }
+
+    bool pop(T& data) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (list.empty()) return false;
+        data = list.getFirst()->data;
+        list.popFront();
+        return true;
+    }
+};
+
+
+// producers push n elements in total, consumers pop all of them
+template <class QueueType>
+void benchmarkProducersConsumers(const std::string& queueName, size_t threadsCount, size_t n) {
+    QueueType queue;
+    std::atomic<size_t> popped{ 0 };
+    std::vector<std::thread> threads;
+
+    Timer timer;
+    for (size_t t = 0; t < threadsCount; t++) {
+        threads.emplace_back([&queue, n, threadsCount]() {
+            for (size_t i = 0; i < n / threadsCount; i++)
+                queue.push(int(i));
+        });
+        threads.emplace_back([&queue, &popped, n, threadsCount]() {
+            const size_t total = n / threadsCount * threadsCount;
+            int data;
+            while (popped.load(std::memory_order_relaxed) < total)
+                if (queue.pop(data)) popped++;
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    printResult("MPMC threads=" + std::to_string(threadsCount) + "+" + std::to_string(threadsCount),
+        queueName, timer.getElapsedNs() / n);
+}
+
+BENCHMARK(LockFreeMPMC) {
+    const size_t n = size_t(1) << 20;
+    const size_t maxThreads = std::max<size_t>(1, std::thread::hardware_concurrency() / 2);
+    for (size_t threadsCount = 1; threadsCount <= maxThreads * 2; threadsCount *= 2) {
+        benchmarkProducersConsumers<MutexQueue<int>>("List + std::mutex", threadsCount, n);
+        benchmarkProducersConsumers<LockFreeQueue<int>>("LockFreeQueue", threadsCount, n);
+        benchmarkProducersConsumers<LockFreeStack<int>>("LockFreeStack", threadsCount, n);
+    }
+}
@@ -0,0 +1,62 @@
+#include "PerfectHashTable.h"
+#include "HashTableOpenAddressing.h"
+
+#include "bench.h"
+
+
+// successful and unsuccessful searches of random keys, memory is given per element
+template <class TableType>
+void benchmarkStaticSearches(const std::string& name, const std::string& tableName, TableType& table,
+    const std::vector<KeyType>& keys, size_t n, double buildNs) {
+    const size_t searches = size_t(1) << 22;
+    std::vector<KeyType> hitKeys(searches), missKeys(searches);
+    std::mt19937 gen(3);
+    for (size_t i = 0; i < searches; i++) {
+        hitKeys[i] = keys[gen() % n];
+        missKeys[i] = keys[n + gen() % n];
+    }
+
+    Timer hitTimer;
+    for (KeyType key : hitKeys)
+        doNotOptimize(table.find(key));
+    double hitNs = hitTimer.getElapsedNs() / searches;
+    Timer missTimer;
+    for (KeyType key : missKeys)
+        doNotOptimize(table.find(key));
+    double missNs = missTimer.getElapsedNs() / searches;
+    double bytesPerElement = double(table.getMemoryUsage().getTotal()) / n;
+
+    std::printf("%-32s %-28s build %6.1f  hit %6.1f  miss %6.1f ns  %6.1f bytes/elem\n",
+        name.c_str(), tableName.c_str(), buildNs, hitNs, missNs, bytesPerElement);
+    getBenchmarkRecords().push_back({ "", name, tableName, {
+        { "build_ns", buildNs }, { "find_hit_ns", hitNs }, { "find_miss_ns", missNs },
+        { "bytes_per_element", bytesPerElement } } });
+}
+
+// perfect hash table with different gamma against open addressing for the same keys,
+// build time is given per element
+BENCHMARK(PerfectHashTable) {
+    for (size_t n = 1000; n <= getBenchmarkOptions().maxSize; n *= 10) {
+        std::vector<KeyType> keys = generateKeys(KeyDistribution::SPARSE, 2 * n);
+        std::vector<std::pair<KeyType, int>> elems(n);
+        for (size_t i = 0; i < n; i++)
+            elems[i] = std::make_pair(keys[i], int(i));
+        std::string name = "static n=" + std::to_string(n);
+
+        Timer timer;
+        HashTableOpenAddressing<int> openAddressing;
+        for (const std::pair<KeyType, int>& elem : elems)
+            openAddressing.insert(elem.first, elem.second);
+        benchmarkStaticSearches(name, "OpenAddressing", openAddressing, keys, n, timer.getElapsedNs() / n);
+
+        for (double gamma : { 1.0, 1.5, 2.0 }) {
+            Timer perfectTimer;
+            PerfectHashTable<int> table(elems, gamma);
+            double buildNs = perfectTimer.getElapsedNs() / n;
+            char tableName[64];
+            std::snprintf(tableName, sizeof(tableName), "Perfect gamma %.1f (%.2f bits/key)",
+                gamma, table.getBitsPerKey());
+            benchmarkStaticSearches(name, tableName, table, keys, n, buildNs);
+        }
+    }
+}
@@ -0,0 +1,170 @@
+#include "UnorderedTable.h"
+#include "OrderedTable.h"
+#include "HashTableOpenAddressing.h"
+#include "HashTableSeparateChaining.h"
+#include "AdaptiveRadixTree.h"
+#include "DirectAddressTable.h"
+
+#include "bench.h"
+
+#include <cstdint>
+
+
+// element of the given size
+template <size_t Size>
+struct BenchValue {
+    char data[Size] = {};
+
+    BenchValue() {}
+    BenchValue(size_t value) {
+        data[0] = char(value);
+    }
+};
+
+enum class KeyChooser { UNIFORM, ZIPF, SEQUENTIAL };
+
+inline const char* getName(KeyChooser chooser) {
+    switch (chooser) {
+    case KeyChooser::UNIFORM: return "uniform";
+    case KeyChooser::ZIPF: return "zipf";
+    default: return "sequential";
+    }
+}
+
+// share of writes (upsert of existing keys), the other operations are searches
+const unsigned WRITE_PERCENTS_TABLE_WORKLOADS[] = { 0, 5, 50 };
+const size_t OPERATIONS_TABLE_WORKLOADS = size_t(1) << 20;
+const size_t LATENCY_SAMPLES_TABLE_WORKLOADS = size_t(1) << 16;
+
+// sizes 10^2..options.maxSize, but not more than maxTableSize
+inline std::vector<size_t> getWorkloadSizes(size_t maxTableSize) {
+    std::vector<size_t> sizes;
+    for (size_t n = 100; n <= std::min(maxTableSize, getBenchmarkOptions().maxSize); n *= 10)
+        sizes.push_back(n);
+    return sizes;
+}
+
+// overhead of Timer, it is subtracted from latencies of single operations
+inline double getTimerOverheadNs() {
+    static double overhead = -1;
+    if (overhead < 0) {
+        overhead = 1e9;
+        for (int i = 0; i < 1000; i++) {
+            Timer timer;
+            overhead = std::min(overhead, timer.getElapsedNs());
+        }
+    }
+    return overhead;
+}
+
+// keys of operations of the workload, keys of the table are keys[0..n-1]
+inline std::vector<KeyType> generateOperationKeys(const std::vector<KeyType>& keys, KeyChooser chooser,
+    size_t count, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::vector<KeyType> operationKeys(count);
+    switch (chooser) {
+    case KeyChooser::UNIFORM:
+        for (KeyType& key : operationKeys)
+            key = keys[gen() % keys.size()];
+        break;
+    case KeyChooser::ZIPF: {
+        ZipfGenerator zipf(keys.size());  // keys are shuffled, so hot keys are random
+        for (KeyType& key : operationKeys)
+            key = keys[zipf(gen)];
+        break;
+    }
+    default:
+        for (size_t i = 0; i < count; i++)
+            operationKeys[i] = keys[i % keys.size()];
+    }
+    return operationKeys;
+}
+
+template <class TableType>
+void runMixOperation(TableType& table, KeyType key, bool isWrite) {
+    if (isWrite)
+        table.upsert(key, typename TableType::elem_type(key));
+    else
+        doNotOptimize(table.find(key));
+}
+
+// runs mixes of searches and writes on the filled table
+template <class TableType>
+void runMixes(TableType& table, const std::string& tableName, const std::string& name,
+    const std::vector<KeyType>& keys, KeyChooser chooser, double memoryMb) {
+    std::vector<KeyType> operationKeys = generateOperationKeys(keys, chooser, OPERATIONS_TABLE_WORKLOADS, 5);
+    std::vector<KeyType> sampleKeys = generateOperationKeys(keys, chooser, LATENCY_SAMPLES_TABLE_WORKLOADS, 6);
+
+    for (unsigned writePercent : WRITE_PERCENTS_TABLE_WORKLOADS) {
+        std::mt19937 gen(7);
+        std::vector<uint8_t> isWrite(OPERATIONS_TABLE_WORKLOADS);
+        for (uint8_t& write : isWrite)
+            write = gen() % 100 < writePercent;
+
+        // throughput
+        Timer timer;
+        for (size_t i = 0; i < OPERATIONS_TABLE_WORKLOADS; i++)
+            runMixOperation(table, operationKeys[i], isWrite[i] != 0);
+        double nsPerOp = timer.getElapsedNs() / OPERATIONS_TABLE_WORKLOADS;
+
+        // latencies of single operations
+        std::vector<double> latencies(LATENCY_SAMPLES_TABLE_WORKLOADS);
+        for (size_t i = 0; i < LATENCY_SAMPLES_TABLE_WORKLOADS; i++) {
+            Timer operationTimer;
+            runMixOperation(table, sampleKeys[i], isWrite[i] != 0);
+            latencies[i] = std::max(0.0, operationTimer.getElapsedNs() - getTimerOverheadNs());
+        }
+        LatencySummary summary = getLatencySummary(latencies);
+
+        std::string mixName = name + " r" + std::to_string(100 - writePercent) + "/w" + std::to_string(writePercent);
+        std::printf("%-36s %-26s %8.2f Mops/s  p50 %7.1f  p99 %8.1f  p99.9 %8.1f ns  mem %8.1f MB\n",
+            mixName.c_str(), tableName.c_str(), 1e3 / nsPerOp, summary.p50, summary.p99, summary.p999, memoryMb);
+        getBenchmarkRecords().push_back({ "", mixName, tableName, {
+            { "ops_per_sec", 1e9 / nsPerOp }, { "ns_per_op", nsPerOp },
+            { "p50_ns", summary.p50 }, { "p90_ns", summary.p90 }, { "p99_ns", summary.p99 },
+            { "p999_ns", summary.p999 }, { "max_ns", summary.max },
+            { "table_memory_mb", memoryMb }, { "peak_rss_mb", getPeakRssMb() } } });
+    }
+}
+
+// tables with up to maxTableSize elements for all key choosers
+template <class TableType>
+void benchmarkWorkloads(const std::string& tableName, size_t maxTableSize) {
+    for (size_t n : getWorkloadSizes(maxTableSize))
+        for (KeyChooser chooser : { KeyChooser::UNIFORM, KeyChooser::ZIPF, KeyChooser::SEQUENTIAL }) {
+            // sequential keys are 0..n-1 inserted in ascending order, the others are random
+            std::vector<KeyType> keys = generateKeys(KeyDistribution::SPARSE, n);
+            if (chooser == KeyChooser::SEQUENTIAL)
+                for (size_t i = 0; i < n; i++) keys[i] = KeyType(i);
+            std::string name = "n=" + std::to_string(n) + " " + getName(chooser)
+                + " v" + std::to_string(sizeof(typename TableType::elem_type));
+
+            try {
+                double rssBefore = getCurrentRssMb();
+                TableType table;
+                for (KeyType key : keys)
+                    table.insert(key, typename TableType::elem_type(key));
+                runMixes(table, tableName, name, keys, chooser, getCurrentRssMb() - rssBefore);
+            }
+            catch (const char* error) {  // e.g. keys are too sparse for direct addressing
+                std::printf("%-36s %-26s skipped: %s\n", name.c_str(), tableName.c_str(), error);
+            }
+        }
+}
+
+// every table is run with small and large elements
+// O(n) tables are run on small sizes only
+template <template<class...> class TableType>
+void benchmarkTableWorkloads(const std::string& tableName, size_t maxTableSize = SIZE_MAX) {
+    benchmarkWorkloads<TableType<BenchValue<8>>>(tableName, maxTableSize);
+    benchmarkWorkloads<TableType<BenchValue<128>>>(tableName, maxTableSize);
+}
+
+BENCHMARK(TableWorkloads) {
+    benchmarkTableWorkloads<UnorderedTable>("UnorderedTable", 1000);
+    benchmarkTableWorkloads<OrderedTable>("OrderedTable", 10000);
+    benchmarkTableWorkloads<HashTableOpenAddressing>("HashTableOpenAddressing");
+    benchmarkTableWorkloads<HashTableSeparateChaining>("HashTableSeparateChaining");
+    benchmarkTableWorkloads<AdaptiveRadixTree>("AdaptiveRadixTree");
+    benchmarkTableWorkloads<DirectAddressTable>("DirectAddressTable");
+}
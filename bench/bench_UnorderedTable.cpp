@@ -0,0 +1,61 @@
+#include "UnorderedTable.h"
+#include "HashTableOpenAddressing.h"
+
+#include "bench.h"
+
+
+// successful search in small tables
+template <class TableType>
+void benchmarkSmallTable(const std::string& tableName, size_t n) {
+    const size_t searches = size_t(1) << 22;
+    std::vector<KeyType> keys = generateKeys(KeyDistribution::SPARSE, n);
+    std::vector<KeyType> searchKeys(searches);
+    std::mt19937 gen(2);
+    for (KeyType& key : searchKeys)
+        key = keys[gen() % n];
+
+    TableType table;
+    for (KeyType key : keys)
+        table.insert(key, int(key));
+
+    Timer timer;
+    for (KeyType key : searchKeys)
+        doNotOptimize(table.find(key));
+    printResult("find n=" + std::to_string(n), tableName, timer.getElapsedNs() / searches);
+}
+
+BENCHMARK(UnorderedTableSmall) {
+    for (size_t n : { 4, 8, 16, 32, 64, 128, 256 }) {
+        benchmarkSmallTable<UnorderedTable<int>>("UnorderedTable", n);
+        benchmarkSmallTable<HashTableOpenAddressing<int>>("HashTableOpenAddressing", n);
+    }
+}
+
+// successful search with Zipf(0.99) distribution of requested keys
+void benchmarkSelfOrganizingPolicy(const std::string& policyName, SelfOrganizingPolicy policy, size_t n) {
+    const size_t searches = size_t(1) << 22;
+    std::vector<KeyType> keys = generateKeys(KeyDistribution::SPARSE, n);  // popularity does not depend on order of insertion
+    std::vector<KeyType> searchKeys(searches);
+    ZipfGenerator zipf(n, 0.99);
+    std::mt19937 gen(2);
+    for (KeyType& key : searchKeys)
+        key = keys[zipf(gen)];
+
+    UnorderedTable<int> table(START_STORAGE_SIZE, policy);
+    for (size_t i = n; i > 0; i--)  // the hottest keys are the last ones
+        table.insert(keys[i - 1], int(i));
+
+    Timer timer;
+    for (KeyType key : searchKeys)
+        doNotOptimize(table.find(key));
+    printResult("zipf(0.99) find n=" + std::to_string(n), policyName, timer.getElapsedNs() / searches);
+}
+
+BENCHMARK(UnorderedTableSelfOrganizing) {
+    for (size_t n : { 16, 64, 256, 1024 }) {
+        benchmarkSelfOrganizingPolicy("NONE", SelfOrganizingPolicy::NONE, n);
+        benchmarkSelfOrganizingPolicy("MOVE_TO_FRONT", SelfOrganizingPolicy::MOVE_TO_FRONT, n);
+        benchmarkSelfOrganizingPolicy("TRANSPOSE", SelfOrganizingPolicy::TRANSPOSE, n);
+        benchmarkSelfOrganizingPolicy("COUNT", SelfOrganizingPolicy::COUNT, n);
+    }
+}
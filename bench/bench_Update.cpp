@@ -0,0 +1,44 @@
+#include "HashTableOpenAddressing.h"
+#include "HashTableSeparateChaining.h"
+#include "AdaptiveRadixTree.h"
+
+#include "bench.h"
+
+
+// counting of events: read-modify-write of the element for every key
+template <class TableType>
+void benchmarkCounting(const std::string& tableName, size_t distinctKeys) {
+    const size_t events = size_t(1) << 22;
+    std::vector<KeyType> keys = generateKeys(KeyDistribution::SPARSE, distinctKeys);
+    std::vector<KeyType> eventKeys(events);
+    std::mt19937 gen(3);
+    for (KeyType& key : eventKeys)
+        key = keys[gen() % distinctKeys];
+    const std::string suffix = " keys=" + std::to_string(distinctKeys);
+
+    {
+        TableType table;
+        Timer timer;
+        for (KeyType key : eventKeys) {
+            auto elem = table.find(key);
+            if (elem) elem->second++;
+            else table.insert(key, 1);
+        }
+        printResult("find+insert" + suffix, tableName, timer.getElapsedNs() / events);
+    }
+    {
+        TableType table;
+        Timer timer;
+        for (KeyType key : eventKeys)
+            table.update(key, [](int& count) { count++; });
+        printResult("update" + suffix, tableName, timer.getElapsedNs() / events);
+    }
+}
+
+BENCHMARK(CountingUpdate) {
+    for (size_t n : { size_t(1) << 10, size_t(1) << 16, size_t(1) << 20 }) {
+        benchmarkCounting<HashTableOpenAddressing<int>>("HashTableOpenAddressing", n);
+        benchmarkCounting<HashTableSeparateChaining<int>>("HashTableSeparateChaining", n);
+        benchmarkCounting<AdaptiveRadixTree<int>>("AdaptiveRadixTree", n);
+    }
+}
@@ -0,0 +1,42 @@
+#include "HashTableOpenAddressing.h"
+#include "HashTableSeparateChaining.h"
+#include "AdaptiveRadixTree.h"
+
+#include "bench.h"
+
+
+// replays the workload on a table loaded with its records
+// latencies include the overhead of the clock
+template <class TableType>
+void benchmarkWorkload(const std::string& workloadName, const std::string& tableName, const WorkloadSpec& spec) {
+    WorkloadGenerator generator(spec);
+    TableType table;
+    loadWorkload(table, generator);
+    std::vector<Operation> operations = generator.generate();
+
+    WorkloadResult result = runWorkload(table, operations);
+    double nsPerOp = result.totalNs / operations.size();
+    LatencySummary summary = getLatencySummary(result.latenciesNs);
+
+    std::printf("%-24s %-28s %8.2f Mops/s  p50 %7.1f  p99 %8.1f  p99.9 %8.1f ns\n",
+        workloadName.c_str(), tableName.c_str(), 1e3 / nsPerOp, summary.p50, summary.p99, summary.p999);
+    getBenchmarkRecords().push_back({ "", workloadName, tableName, {
+        { "ops_per_sec", 1e9 / nsPerOp }, { "p50_ns", summary.p50 }, { "p90_ns", summary.p90 },
+        { "p99_ns", summary.p99 }, { "p999_ns", summary.p999 }, { "max_ns", summary.max } } });
+}
+
+template <class TableType>
+void benchmarkYcsb(const std::string& tableName) {
+    const size_t records = std::min<size_t>(getBenchmarkOptions().maxSize, 1000000);
+    const size_t operations = size_t(1) << 20;
+    for (char name : { 'A', 'B', 'C', 'D', 'E', 'F' })
+        benchmarkWorkload<TableType>(std::string("ycsb-") + name, tableName, getYcsbWorkload(name, records, operations));
+    benchmarkWorkload<TableType>("insert-ramp", tableName, getInsertRampWorkload(records, operations));
+    benchmarkWorkload<TableType>("delete-churn", tableName, getDeleteChurnWorkload(records, operations));
+}
+
+BENCHMARK(Ycsb) {
+    benchmarkYcsb<HashTableOpenAddressing<int>>("HashTableOpenAddressing");
+    benchmarkYcsb<HashTableSeparateChaining<int>>("HashTableSeparateChaining");
+    benchmarkYcsb<AdaptiveRadixTree<int>>("AdaptiveRadixTree");
+}
@@ -0,0 +1,34 @@
+#include "bench.h"
+
+#include <cstdlib>
+#include <cstring>
+
+int main(int argc, char **argv)
+{
+  const char* filter = "";
+  BenchmarkOptions& options = getBenchmarkOptions();
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+      options.jsonPath = argv[++i];
+    else if (std::strcmp(argv[i], "--max-size") == 0 && i + 1 < argc)
+      options.maxSize = size_t(std::strtoull(argv[++i], nullptr, 10));
+    else
+      filter = argv[i];
+  }
+
+  std::vector<BenchmarkRecord>& records = getBenchmarkRecords();
+  for (const Benchmark& benchmark : getBenchmarks())
+    if (benchmark.name.find(filter) != std::string::npos) {
+      std::printf("[ %s ]\n", benchmark.name.c_str());
+      size_t firstRecord = records.size();
+      benchmark.function();
+      for (size_t i = firstRecord; i < records.size(); i++)
+        records[i].benchmark = benchmark.name;
+    }
+
+  if (!options.jsonPath.empty() && !saveBenchmarkRecords(options.jsonPath)) {
+    std::printf("Can't write %s\n", options.jsonPath.c_str());
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,639 @@
+#pragma once
+#include "Table.h"
+#include "Intrinsics.h"
+
+#include <cstring>
+
+
+// adaptive radix tree over the bytes of KeyType (most significant byte first)
+// inner nodes have 4, 16, 48 or 256 children and grow/shrink on insertion/erasing,
+// common key bytes are stored in inner nodes (path compression),
+// leaves are placed as high as possible (lazy expansion)
+// elements are ordered by key, so the tree supports ordered iteration and range scans
+template <class ElemType>
+class AdaptiveRadixTree : public StaticTableInterface<AdaptiveRadixTree<ElemType>, ElemType> {
+
+    static const size_t KEY_LENGTH = sizeof(KeyType);
+
+    enum NodeType : uint8_t { LEAF, NODE4, NODE16, NODE48, NODE256 };
+
+    struct ArtNode {
+        NodeType type;
+
+        ArtNode(NodeType type) : type(type) {}
+    };
+
+    struct Leaf : ArtNode {
+        std::pair<KeyType, ElemType> data;
+
+        Leaf(const KeyType& key, const ElemType& elem) : ArtNode(LEAF), data(key, elem) {}
+    };
+
+    struct InnerNode : ArtNode {
+        uint16_t numChildren = 0;
+        uint8_t prefixLength = 0;
+        uint8_t prefix[KEY_LENGTH] = {};  // common bytes of all keys in the subtree
+
+        InnerNode(NodeType type) : ArtNode(type) {}
+    };
+
+    // keys are sorted
+    struct Node4 : InnerNode {
+        uint8_t keys[4] = {};
+        ArtNode* children[4] = {};
+
+        Node4() : InnerNode(NODE4) {}
+    };
+
+    // keys are sorted, search uses SIMD if possible
+    struct Node16 : InnerNode {
+        uint8_t keys[16] = {};
+        ArtNode* children[16] = {};
+
+        Node16() : InnerNode(NODE16) {}
+    };
+
+    // childIndex[byte] is 1 + position of the child, 0 if there is no child
+    struct Node48 : InnerNode {
+        uint8_t childIndex[256] = {};
+        ArtNode* children[48] = {};
+
+        Node48() : InnerNode(NODE48) {}
+    };
+
+    struct Node256 : InnerNode {
+        ArtNode* children[256] = {};
+
+        Node256() : InnerNode(NODE256) {}
+    };
+
+    ArtNode* root = nullptr;
+    size_t size = 0;
+
+    static uint8_t getKeyByte(const KeyType& key, size_t depth) {
+        return uint8_t(key >> (8 * (KEY_LENGTH - 1 - depth)));
+    }
+
+    // keys of a subtree at given depth differ only in bits of this mask
+    static KeyType getSubtreeMask(size_t depth) {
+        return KeyType((uint64_t(1) << (8 * (KEY_LENGTH - depth))) - 1);
+    }
+
+    static void copyHeader(InnerNode* dst, const InnerNode* src) {
+        dst->numChildren = src->numChildren;
+        dst->prefixLength = src->prefixLength;
+        std::memcpy(dst->prefix, src->prefix, KEY_LENGTH);
+    }
+
+    // returns the number of prefix bytes equal to the bytes of the key
+    static size_t checkPrefix(const InnerNode* node, const KeyType& key, size_t depth) {
+        size_t i = 0;
+        for (; i < node->prefixLength; i++)
+            if (node->prefix[i] != getKeyByte(key, depth + i)) break;
+        return i;
+    }
+
+    // returns pointer to the slot with child or nullptr
+    static ArtNode** findChild(InnerNode* node, uint8_t byte) {
+        switch (node->type) {
+        case NODE4: {
+            Node4* n = static_cast<Node4*>(node);
+            for (size_t i = 0; i < n->numChildren; i++)
+                if (n->keys[i] == byte) return &(n->children[i]);
+            return nullptr;
+        }
+        case NODE16: {
+            Node16* n = static_cast<Node16*>(node);
+#ifdef DATA_STRUCTURES_SSE2
+            __m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8((char)byte),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(n->keys)));
+            uint32_t mask = (uint32_t)_mm_movemask_epi8(cmp) & ((uint32_t(1) << n->numChildren) - 1);
+            if (mask) return &(n->children[countTrailingZeros(mask)]);
+#else
+            for (size_t i = 0; i < n->numChildren; i++)
+                if (n->keys[i] == byte) return &(n->children[i]);
+#endif
+            return nullptr;
+        }
+        case NODE48: {
+            Node48* n = static_cast<Node48*>(node);
+            if (!n->childIndex[byte]) return nullptr;
+            return &(n->children[n->childIndex[byte] - 1]);
+        }
+        case NODE256: {
+            Node256* n = static_cast<Node256*>(node);
+            if (!n->children[byte]) return nullptr;
+            return &(n->children[byte]);
+        }
+        default:
+            return nullptr;
+        }
+    }
+
+    // inserts child into sorted arrays of Node4 or Node16
+    template <class NodeWithSortedKeys>
+    static void insertSorted(NodeWithSortedKeys* node, uint8_t byte, ArtNode* child) {
+        size_t pos = 0;
+        while (pos < node->numChildren && node->keys[pos] < byte) pos++;
+        for (size_t i = node->numChildren; i > pos; i--) {
+            node->keys[i] = node->keys[i - 1];
+            node->children[i] = node->children[i - 1];
+        }
+        node->keys[pos] = byte;
+        node->children[pos] = child;
+        node->numChildren++;
+    }
+
+    // adds child to the node, grows the node if it is full
+    // nodeRef is the slot of the node in its parent
+    static void addChild(ArtNode** nodeRef, InnerNode* node, uint8_t byte, ArtNode* child) {
+        switch (node->type) {
+        case NODE4: {
+            Node4* n = static_cast<Node4*>(node);
+            if (n->numChildren < 4) {
+                insertSorted(n, byte, child);
+                return;
+            }
+            Node16* newNode = new Node16();
+            copyHeader(newNode, n);
+            std::memcpy(newNode->keys, n->keys, sizeof(n->keys));
+            std::memcpy(newNode->children, n->children, sizeof(n->children));
+            delete n;
+            *nodeRef = newNode;
+            insertSorted(newNode, byte, child);
+            return;
+        }
+        case NODE16: {
+            Node16* n = static_cast<Node16*>(node);
+            if (n->numChildren < 16) {
+                insertSorted(n, byte, child);
+                return;
+            }
+            Node48* newNode = new Node48();
+            copyHeader(newNode, n);
+            for (size_t i = 0; i < n->numChildren; i++) {
+                newNode->childIndex[n->keys[i]] = uint8_t(i + 1);
+                newNode->children[i] = n->children[i];
+            }
+            delete n;
+            *nodeRef = newNode;
+            addChild(nodeRef, newNode, byte, child);
+            return;
+        }
+        case NODE48: {
+            Node48* n = static_cast<Node48*>(node);
+            if (n->numChildren < 48) {
+                size_t pos = 0;
+                while (n->children[pos]) pos++;
+                n->children[pos] = child;
+                n->childIndex[byte] = uint8_t(pos + 1);
+                n->numChildren++;
+                return;
+            }
+            Node256* newNode = new Node256();
+            copyHeader(newNode, n);
+            for (size_t b = 0; b < 256; b++)
+                if (n->childIndex[b]) newNode->children[b] = n->children[n->childIndex[b] - 1];
+            delete n;
+            *nodeRef = newNode;
+            addChild(nodeRef, newNode, byte, child);
+            return;
+        }
+        case NODE256: {
+            Node256* n = static_cast<Node256*>(node);
+            n->children[byte] = child;
+            n->numChildren++;
+            return;
+        }
+        default:
+            return;
+        }
+    }
+
+    // removes child from the node, shrinks the node if it is almost empty
+    // nodeRef is the slot of the node in its parent
+    static void removeChild(ArtNode** nodeRef, InnerNode* node, uint8_t byte) {
+        switch (node->type) {
+        case NODE4: {
+            Node4* n = static_cast<Node4*>(node);
+            removeSorted(n, byte);
+            if (n->numChildren == 1) {  // the node is not needed anymore
+                ArtNode* child = n->children[0];
+                if (child->type != LEAF) {  // concatenate prefixes
+                    InnerNode* innerChild = static_cast<InnerNode*>(child);
+                    uint8_t prefix[KEY_LENGTH];
+                    size_t length = n->prefixLength;
+                    std::memcpy(prefix, n->prefix, length);
+                    prefix[length++] = n->keys[0];
+                    std::memcpy(prefix + length, innerChild->prefix, innerChild->prefixLength);
+                    length += innerChild->prefixLength;
+                    std::memcpy(innerChild->prefix, prefix, length);
+                    innerChild->prefixLength = uint8_t(length);
+                }
+                delete n;
+                *nodeRef = child;
+            }
+            return;
+        }
+        case NODE16: {
+            Node16* n = static_cast<Node16*>(node);
+            removeSorted(n, byte);
+            if (n->numChildren == 3) {
+                Node4* newNode = new Node4();
+                copyHeader(newNode, n);
+                std::memcpy(newNode->keys, n->keys, 3);
+                std::memcpy(newNode->children, n->children, 3 * sizeof(ArtNode*));
+                delete n;
+                *nodeRef = newNode;
+            }
+            return;
+        }
+        case NODE48: {
+            Node48* n = static_cast<Node48*>(node);
+            n->children[n->childIndex[byte] - 1] = nullptr;
+            n->childIndex[byte] = 0;
+            n->numChildren--;
+            if (n->numChildren == 12) {
+                Node16* newNode = new Node16();
+                copyHeader(newNode, n);
+                size_t pos = 0;
+                for (size_t b = 0; b < 256; b++)
+                    if (n->childIndex[b]) {
+                        newNode->keys[pos] = uint8_t(b);
+                        newNode->children[pos] = n->children[n->childIndex[b] - 1];
+                        pos++;
+                    }
+                delete n;
+                *nodeRef = newNode;
+            }
+            return;
+        }
+        case NODE256: {
+            Node256* n = static_cast<Node256*>(node);
+            n->children[byte] = nullptr;
+            n->numChildren--;
+            if (n->numChildren == 37) {
+                Node48* newNode = new Node48();
+                copyHeader(newNode, n);
+                size_t pos = 0;
+                for (size_t b = 0; b < 256; b++)
+                    if (n->children[b]) {
+                        newNode->childIndex[b] = uint8_t(pos + 1);
+                        newNode->children[pos] = n->children[b];
+                        pos++;
+                    }
+                delete n;
+                *nodeRef = newNode;
+            }
+            return;
+        }
+        default:
+            return;
+        }
+    }
+
+    template <class NodeWithSortedKeys>
+    static void removeSorted(NodeWithSortedKeys* node, uint8_t byte) {
+        size_t pos = 0;
+        while (node->keys[pos] != byte) pos++;
+        for (size_t i = pos + 1; i < node->numChildren; i++) {
+            node->keys[i - 1] = node->keys[i];
+            node->children[i - 1] = node->children[i];
+        }
+        node->numChildren--;
+        node->children[node->numChildren] = nullptr;
+    }
+
+    static void destroy(ArtNode* node) {
+        if (!node) return;
+        switch (node->type) {
+        case LEAF:
+            delete static_cast<Leaf*>(node);
+            return;
+        case NODE4: {
+            Node4* n = static_cast<Node4*>(node);
+            for (size_t i = 0; i < n->numChildren; i++) destroy(n->children[i]);
+            delete n;
+            return;
+        }
+        case NODE16: {
+            Node16* n = static_cast<Node16*>(node);
+            for (size_t i = 0; i < n->numChildren; i++) destroy(n->children[i]);
+            delete n;
+            return;
+        }
+        case NODE48: {
+            Node48* n = static_cast<Node48*>(node);
+            for (size_t i = 0; i < 48; i++) destroy(n->children[i]);
+            delete n;
+            return;
+        }
+        case NODE256: {
+            Node256* n = static_cast<Node256*>(node);
+            for (size_t i = 0; i < 256; i++) destroy(n->children[i]);
+            delete n;
+            return;
+        }
+        }
+    }
+
+    // inner node with capacity children, its free slots of children are slack
+    template <class InnerNodeType>
+    static void addInnerMemoryUsage(const InnerNodeType* node, size_t capacity, size_t slotSize, MemoryUsage& res) {
+        res.nodeBytes += sizeof(InnerNodeType);
+        res.slackBytes += (capacity - node->numChildren) * slotSize;
+        res.metadataBytes += sizeof(InnerNodeType) - (capacity - node->numChildren) * slotSize;
+    }
+
+    static void addMemoryUsage(const ArtNode* node, MemoryUsage& res) {
+        switch (node->type) {
+        case LEAF: {
+            const Leaf* leaf = static_cast<const Leaf*>(node);
+            res.nodeBytes += sizeof(Leaf);
+            res.elementBytes += sizeof(leaf->data);
+            res.metadataBytes += sizeof(Leaf) - sizeof(leaf->data);
+            res.elementHeapBytes += getHeapBytes(leaf->data.second);
+            return;
+        }
+        case NODE4: {
+            const Node4* n = static_cast<const Node4*>(node);
+            addInnerMemoryUsage(n, 4, sizeof(uint8_t) + sizeof(ArtNode*), res);
+            for (size_t i = 0; i < n->numChildren; i++) addMemoryUsage(n->children[i], res);
+            return;
+        }
+        case NODE16: {
+            const Node16* n = static_cast<const Node16*>(node);
+            addInnerMemoryUsage(n, 16, sizeof(uint8_t) + sizeof(ArtNode*), res);
+            for (size_t i = 0; i < n->numChildren; i++) addMemoryUsage(n->children[i], res);
+            return;
+        }
+        case NODE48: {
+            const Node48* n = static_cast<const Node48*>(node);
+            addInnerMemoryUsage(n, 48, sizeof(ArtNode*), res);
+            for (size_t i = 0; i < 48; i++)
+                if (n->children[i]) addMemoryUsage(n->children[i], res);
+            return;
+        }
+        case NODE256: {
+            const Node256* n = static_cast<const Node256*>(node);
+            addInnerMemoryUsage(n, 256, sizeof(ArtNode*), res);
+            for (size_t i = 0; i < 256; i++)
+                if (n->children[i]) addMemoryUsage(n->children[i], res);
+            return;
+        }
+        }
+    }
+
+    static ArtNode* copy(const ArtNode* node) {
+        if (!node) return nullptr;
+        switch (node->type) {
+        case LEAF:
+            return new Leaf(*static_cast<const Leaf*>(node));
+        case NODE4:
+            return copyChildren(new Node4(*static_cast<const Node4*>(node)));
+        case NODE16:
+            return copyChildren(new Node16(*static_cast<const Node16*>(node)));
+        case NODE48:
+            return copyChildren(new Node48(*static_cast<const Node48*>(node)));
+        case NODE256:
+            return copyChildren(new Node256(*static_cast<const Node256*>(node)));
+        }
+        return nullptr;
+    }
+
+    template <class InnerNodeType>
+    static ArtNode* copyChildren(InnerNodeType* node) {
+        for (ArtNode*& child : node->children)
+            child = copy(child);
+        return node;
+    }
+
+    // calls function for all elements of subtree with keys from [left, right] in ascending order
+    // path contains key bytes from 0 to depth - 1
+    template <class Function>
+    static void visitRange(ArtNode* node, KeyType path, size_t depth,
+        const KeyType& left, const KeyType& right, Function& function) {
+        if (node->type == LEAF) {
+            std::pair<KeyType, ElemType>& data = static_cast<Leaf*>(node)->data;
+            if (left <= data.first && data.first <= right) function(data);
+            return;
+        }
+
+        InnerNode* inner = static_cast<InnerNode*>(node);
+        for (size_t i = 0; i < inner->prefixLength; i++, depth++)
+            path |= KeyType(inner->prefix[i]) << (8 * (KEY_LENGTH - 1 - depth));
+        if (path > right || (path | getSubtreeMask(depth)) < left) return;  // subtree is out of range
+
+        size_t shift = 8 * (KEY_LENGTH - 1 - depth);
+        switch (inner->type) {
+        case NODE4: {
+            Node4* n = static_cast<Node4*>(inner);
+            for (size_t i = 0; i < n->numChildren; i++)
+                visitRange(n->children[i], path | (KeyType(n->keys[i]) << shift), depth + 1, left, right, function);
+            return;
+        }
+        case NODE16: {
+            Node16* n = static_cast<Node16*>(inner);
+            for (size_t i = 0; i < n->numChildren; i++)
+                visitRange(n->children[i], path | (KeyType(n->keys[i]) << shift), depth + 1, left, right, function);
+            return;
+        }
+        case NODE48: {
+            Node48* n = static_cast<Node48*>(inner);
+            for (size_t b = 0; b < 256; b++)
+                if (n->childIndex[b])
+                    visitRange(n->children[n->childIndex[b] - 1], path | (KeyType(b) << shift), depth + 1, left, right, function);
+            return;
+        }
+        case NODE256: {
+            Node256* n = static_cast<Node256*>(inner);
+            for (size_t b = 0; b < 256; b++)
+                if (n->children[b])
+                    visitRange(n->children[b], path | (KeyType(b) << shift), depth + 1, left, right, function);
+            return;
+        }
+        default:
+            return;
+        }
+    }
+
+public:
+
+    AdaptiveRadixTree() {}
+
+    AdaptiveRadixTree(const AdaptiveRadixTree& tree) : root(copy(tree.root)), size(tree.size) {}
+
+    ~AdaptiveRadixTree() {
+        destroy(root);
+    }
+
+    AdaptiveRadixTree& operator=(const AdaptiveRadixTree& tree) {
+        if (&tree != this) {
+            clear();
+            root = copy(tree.root);
+            size = tree.size;
+        }
+        return *this;
+    }
+
+    // search O(k), k = sizeof(KeyType)
+    std::pair<KeyType, ElemType>* find(const KeyType& key) {
+        ArtNode* node = root;
+        size_t depth = 0;
+        while (node) {
+            if (node->type == LEAF) {
+                Leaf* leaf = static_cast<Leaf*>(node);
+                if (leaf->data.first != key) return nullptr;
+                return &(leaf->data);
+            }
+            InnerNode* inner = static_cast<InnerNode*>(node);
+            if (checkPrefix(inner, key, depth) != inner->prefixLength) return nullptr;
+            depth += inner->prefixLength;
+            ArtNode** child = findChild(inner, getKeyByte(key, depth));
+            if (!child) return nullptr;
+            node = *child;
+            depth++;
+        }
+        return nullptr;
+    }
+
+    // insertion O(k)
+    bool insert(const KeyType& key, const ElemType& elem) {
+        return findOrInsert(key, elem).second;
+    }
+
+    // search and insertion in one descent O(k)
+    std::pair<std::pair<KeyType, ElemType>*, bool> findOrInsert(const KeyType& key, const ElemType& elem) {
+        ArtNode** nodeRef = &root;
+        size_t depth = 0;
+        while (true) {
+            ArtNode* node = *nodeRef;
+
+            if (!node) {  // empty tree
+                Leaf* newLeaf = new Leaf(key, elem);
+                *nodeRef = newLeaf;
+                size++;
+                return std::make_pair(&(newLeaf->data), true);
+            }
+
+            if (node->type == LEAF) {
+                Leaf* leaf = static_cast<Leaf*>(node);
+                if (leaf->data.first == key)  // key already exists
+                    return std::make_pair(&(leaf->data), false);
+
+                // replace leaf by a node with two leaves, common bytes become a prefix
+                Node4* newNode = new Node4();
+                size_t i = depth;
+                for (; getKeyByte(key, i) == getKeyByte(leaf->data.first, i); i++)
+                    newNode->prefix[i - depth] = getKeyByte(key, i);
+                newNode->prefixLength = uint8_t(i - depth);
+                Leaf* newLeaf = new Leaf(key, elem);
+                insertSorted(newNode, getKeyByte(leaf->data.first, i), leaf);
+                insertSorted(newNode, getKeyByte(key, i), newLeaf);
+                *nodeRef = newNode;
+                size++;
+                return std::make_pair(&(newLeaf->data), true);
+            }
+
+            InnerNode* inner = static_cast<InnerNode*>(node);
+            size_t prefixMatch = checkPrefix(inner, key, depth);
+            if (prefixMatch != inner->prefixLength) {
+                // split prefix, new node contains the matched part of it
+                Node4* newNode = new Node4();
+                newNode->prefixLength = uint8_t(prefixMatch);
+                std::memcpy(newNode->prefix, inner->prefix, prefixMatch);
+                uint8_t innerByte = inner->prefix[prefixMatch];
+                inner->prefixLength = uint8_t(inner->prefixLength - prefixMatch - 1);
+                std::memmove(inner->prefix, inner->prefix + prefixMatch + 1, inner->prefixLength);
+                Leaf* newLeaf = new Leaf(key, elem);
+                insertSorted(newNode, innerByte, inner);
+                insertSorted(newNode, getKeyByte(key, depth + prefixMatch), newLeaf);
+                *nodeRef = newNode;
+                size++;
+                return std::make_pair(&(newLeaf->data), true);
+            }
+
+            depth += inner->prefixLength;
+            uint8_t byte = getKeyByte(key, depth);
+            ArtNode** child = findChild(inner, byte);
+            if (!child) {
+                Leaf* newLeaf = new Leaf(key, elem);
+                addChild(nodeRef, inner, byte, newLeaf);
+                size++;
+                return std::make_pair(&(newLeaf->data), true);
+            }
+            nodeRef = child;
+            depth++;
+        }
+    }
+
+    // erasing O(k)
+    bool erase(const KeyType& key) {
+        ArtNode** nodeRef = &root;
+        size_t depth = 0;
+        while (ArtNode* node = *nodeRef) {
+            if (node->type == LEAF) {  // the tree consists of one leaf
+                if (static_cast<Leaf*>(node)->data.first != key) return false;
+                delete static_cast<Leaf*>(node);
+                *nodeRef = nullptr;
+                size--;
+                return true;
+            }
+
+            InnerNode* inner = static_cast<InnerNode*>(node);
+            if (checkPrefix(inner, key, depth) != inner->prefixLength) return false;
+            depth += inner->prefixLength;
+            uint8_t byte = getKeyByte(key, depth);
+            ArtNode** child = findChild(inner, byte);
+            if (!child) return false;
+
+            if ((*child)->type == LEAF) {
+                Leaf* leaf = static_cast<Leaf*>(*child);
+                if (leaf->data.first != key) return false;
+                removeChild(nodeRef, inner, byte);
+                delete leaf;
+                size--;
+                return true;
+            }
+            nodeRef = child;
+            depth++;
+        }
+        return false;
+    }
+
+    void clear() {
+        destroy(root);
+        root = nullptr;
+        size = 0;
+    }
+
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    size_t getSize() const {
+        return size;
+    }
+
+    // leaves contain elements, inner nodes are metadata, free slots of children are slack, O(n)
+    MemoryUsage getMemoryUsage() const {
+        MemoryUsage res;
+        if (root) addMemoryUsage(root, res);
+        return res;
+    }
+
+    // calls function(std::pair<KeyType, ElemType>&) for all elements in ascending order of keys
+    template <class Function>
+    void forEach(Function function) {
+        forEachInRange(0, KeyType(-1), function);
+    }
+
+    // calls function(std::pair<KeyType, ElemType>&) for elements with keys from [left, right]
+    // in ascending order of keys, subtrees out of the range are skipped
+    template <class Function>
+    void forEachInRange(const KeyType& left, const KeyType& right, Function function) {
+        if (root && left <= right)
+            visitRange(root, 0, 0, left, right, function);
+    }
+
+};
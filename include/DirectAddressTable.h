@@ -0,0 +1,192 @@
+#pragma once
+#include "Table.h"
+#include "Intrinsics.h"
+
+#include <algorithm>
+
+
+const size_t START_WINDOW_SIZE_DIRECT_ADDRESS_TABLE = 64;
+const size_t MAX_WINDOW_SIZE_DIRECT_ADDRESS_TABLE = size_t(1) << 26;
+
+
+// table for keys packed into a small range
+// element with key k is stored in storage[k - base], occupied cells are marked in a bitmap
+// the window [base, base + storage.size()) is moved and extended when a key falls outside of it
+// the window and the bitmap are allocated by Allocator rebound to their types
+template <class ElemType, class Allocator = std::allocator<std::pair<KeyType, ElemType>>>
+class DirectAddressTable : public TableByArray<ElemType, std::pair<KeyType, ElemType>, Allocator>,
+    public StaticTableInterface<DirectAddressTable<ElemType, Allocator>, ElemType> {
+
+    using BaseClass = TableByArray<ElemType, std::pair<KeyType, ElemType>, Allocator>;
+    using Storage = typename BaseClass::Storage;
+    using Bitmap = std::vector<uint64_t, RebindAllocator<Allocator, uint64_t>>;
+
+    KeyType base = 0;
+    Bitmap occupied;  // bit i is set if storage[i] contains an element
+
+    static size_t roundWindowSize(uint64_t windowSize) {
+        return size_t((std::max<uint64_t>(windowSize, 1) + 63) & ~uint64_t(63));
+    }
+
+    bool isOccupied(size_t index) const {
+        return (occupied[index >> 6] >> (index & 63)) & 1;
+    }
+
+    // returns storage.size() if key is out of the window
+    size_t getIndex(const KeyType& key) const {
+        size_t index = size_t(KeyType(key - base));
+        return index < storage.size() ? index : storage.size();
+    }
+
+    // calls function(index) for all occupied cells in ascending order
+    // empty parts of the bitmap are skipped by several words at once
+    template <class Function>
+    void forEachOccupied(Function function) const {
+        const size_t words = occupied.size();
+        size_t w = 0;
+        while (w < words) {
+#if defined(DATA_STRUCTURES_AVX2)
+            if (w + 4 <= words) {
+                __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&occupied[w]));
+                if (_mm256_testz_si256(bits, bits)) {
+                    w += 4;
+                    continue;
+                }
+            }
+#elif defined(DATA_STRUCTURES_SSE2)
+            if (w + 2 <= words) {
+                __m128i bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&occupied[w]));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(bits, _mm_setzero_si128())) == 0xFFFF) {
+                    w += 2;
+                    continue;
+                }
+            }
+#endif
+            for (uint64_t bits = occupied[w]; bits; bits &= bits - 1)
+                function(w * 64 + countTrailingZeros(bits));
+            w++;
+        }
+    }
+
+    // moves the window so that it contains both the key and all elements
+    void rebase(const KeyType& key) {
+        if (size == 0) {  // there is nothing to move
+            base = key - key % 64;
+            if (uint64_t(base) + storage.size() > (uint64_t(1) << 32))
+                base = KeyType((uint64_t(1) << 32) - storage.size());
+            return;
+        }
+
+        uint64_t low = std::min<uint64_t>(base, key);
+        uint64_t high = std::max<uint64_t>(uint64_t(base) + storage.size(), uint64_t(key) + 1);
+        if (high - low > MAX_WINDOW_SIZE_DIRECT_ADDRESS_TABLE)
+            throw "Key range is too wide for direct addressing";
+
+        // the window grows at least twice to the side of the key
+        size_t newWindowSize = roundWindowSize(std::min<uint64_t>(
+            std::max<uint64_t>(high - low, uint64_t(storage.size()) * 2), MAX_WINDOW_SIZE_DIRECT_ADDRESS_TABLE));
+        uint64_t newBase = key < base ? (high > newWindowSize ? high - newWindowSize : 0) : low;
+        newBase = std::min<uint64_t>(newBase, (uint64_t(1) << 32) - std::min<uint64_t>(newWindowSize, uint64_t(1) << 32));
+
+        Storage newStorage(newWindowSize, storage.get_allocator());
+        Bitmap newOccupied(newWindowSize / 64, 0, occupied.get_allocator());
+        forEachOccupied([&](size_t index) {
+            size_t newIndex = size_t(storage[index].first - newBase);
+            std::swap(newStorage[newIndex], storage[index]);
+            newOccupied[newIndex >> 6] |= uint64_t(1) << (newIndex & 63);
+        });
+        std::swap(storage, newStorage);
+        std::swap(occupied, newOccupied);
+        base = KeyType(newBase);
+    }
+
+public:
+
+    // window [base, base + windowSize) is allocated at once
+    DirectAddressTable(size_t windowSize = START_WINDOW_SIZE_DIRECT_ADDRESS_TABLE, KeyType base = 0,
+        const Allocator& allocator = Allocator()) :
+        BaseClass(roundWindowSize(windowSize), allocator), base(base),
+        occupied(storage.size() / 64, 0, typename Bitmap::allocator_type(allocator)) {}
+
+    // search O(1)
+    std::pair<KeyType, ElemType>* find(const KeyType& key) {
+        size_t index = getIndex(key);
+        if (index == storage.size() || !isOccupied(index))
+            return nullptr;
+        return &(storage[index]);
+    }
+
+    // insertion O(1), O(window size) if the window is moved
+    bool insert(const KeyType& key, const ElemType& elem) {
+        return findOrInsert(key, elem).second;
+    }
+
+    std::pair<std::pair<KeyType, ElemType>*, bool> findOrInsert(const KeyType& key, const ElemType& elem) {
+        size_t index = getIndex(key);
+        if (index == storage.size()) {
+            rebase(key);
+            index = getIndex(key);
+        }
+        if (isOccupied(index))  // key already exists
+            return std::make_pair(&(storage[index]), false);
+
+        occupied[index >> 6] |= uint64_t(1) << (index & 63);
+        storage[index] = std::make_pair(key, elem);
+        size++;
+
+        return std::make_pair(&(storage[index]), true);
+    }
+
+    // erasing O(1)
+    bool erase(const KeyType& key) {
+        size_t index = getIndex(key);
+        if (index == storage.size() || !isOccupied(index))  // key does not exist
+            return false;
+
+        occupied[index >> 6] &= ~(uint64_t(1) << (index & 63));
+        storage[index].second = ElemType();
+        size--;
+
+        return true;
+    }
+
+    void clear() {
+        Storage tmp(START_WINDOW_SIZE_DIRECT_ADDRESS_TABLE, storage.get_allocator());
+        std::swap(tmp, storage);
+        occupied.assign(storage.size() / 64, 0);
+        base = 0;
+        size = 0;
+    }
+
+    // empty cells of the window are slack, the bitmap is metadata, O(window size)
+    MemoryUsage getMemoryUsage() const {
+        MemoryUsage res;
+        res.addArray(storage.capacity(), size, sizeof(storage[0]), sizeof(storage[0]));
+        res.addArray(occupied.capacity(), occupied.size(), sizeof(uint64_t), 0);
+        forEachOccupied([&](size_t index) { res.elementHeapBytes += getHeapBytes(storage[index].second); });
+        return res;
+    }
+
+    // number of elements with keys from [left, right], O(window size / 64)
+    size_t countInRange(const KeyType& left, const KeyType& right) const {
+        if (left > right || right < base || (left >= base && left - base >= storage.size())) return 0;
+        size_t from = left < base ? 0 : size_t(left - base);
+        size_t to = std::min<size_t>(size_t(right - base), storage.size() - 1);
+
+        size_t count = 0;
+        for (size_t w = from >> 6; w <= (to >> 6); w++) {
+            uint64_t bits = occupied[w];
+            if (w == (from >> 6)) bits &= ~uint64_t(0) << (from & 63);
+            if (w == (to >> 6)) bits &= ~uint64_t(0) >> (63 - (to & 63));
+            count += popCount(bits);
+        }
+        return count;
+    }
+
+    // calls function(std::pair<KeyType, ElemType>&) for all elements in ascending order of keys
+    template <class Function>
+    void forEach(Function function) {
+        forEachOccupied([&](size_t index) { function(storage[index]); });
+    }
+
+};
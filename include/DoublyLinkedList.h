@@ -0,0 +1,331 @@
+#pragma once
+#include "PoolAllocator.h"
+
+#include <iostream>
+#include <iterator>
+#include <memory>
+
+
+template <class T>
+struct DoublyLinkedNode {
+    T data;
+    DoublyLinkedNode* prev = nullptr;
+    DoublyLinkedNode* next = nullptr;
+
+    DoublyLinkedNode() {}
+    DoublyLinkedNode(const T& data, DoublyLinkedNode* prev = nullptr, DoublyLinkedNode* next = nullptr) :
+        data(data), prev(prev), next(next) {}
+};
+
+
+// bidirectional iterator over nodes, Value is T or const T
+// end() is nullptr node, so it can't be decremented
+template <class T, class Value = T>
+class DoublyLinkedListIterator {
+    DoublyLinkedNode<T>* node;
+
+public:
+
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Value* pointer;
+    typedef Value& reference;
+
+    DoublyLinkedListIterator(DoublyLinkedNode<T>* node = nullptr) : node(node) {}
+
+    operator DoublyLinkedListIterator<T, const T>() const {
+        return DoublyLinkedListIterator<T, const T>(node);
+    }
+
+    DoublyLinkedNode<T>* getNode() const {
+        return node;
+    }
+
+    Value& operator*() const {
+        return node->data;
+    }
+
+    Value* operator->() const {
+        return &(node->data);
+    }
+
+    DoublyLinkedListIterator& operator++() {
+        node = node->next;
+        return *this;
+    }
+
+    DoublyLinkedListIterator operator++(int) {
+        DoublyLinkedListIterator tmp = *this;
+        node = node->next;
+        return tmp;
+    }
+
+    DoublyLinkedListIterator& operator--() {
+        node = node->prev;
+        return *this;
+    }
+
+    DoublyLinkedListIterator operator--(int) {
+        DoublyLinkedListIterator tmp = *this;
+        node = node->prev;
+        return tmp;
+    }
+
+    friend bool operator==(const DoublyLinkedListIterator& it1, const DoublyLinkedListIterator& it2) {
+        return it1.node == it2.node;
+    }
+
+    friend bool operator!=(const DoublyLinkedListIterator& it1, const DoublyLinkedListIterator& it2) {
+        return it1.node != it2.node;
+    }
+};
+
+
+// list with links in both directions, every node can be erased in O(1), so it can be used as a deque
+// interface is the same as of List, nodes are allocated by Allocator rebound to DoublyLinkedNode<T>
+template <class T, class Allocator = PoolAllocator<T>>
+class DoublyLinkedList {
+    using Node = DoublyLinkedNode<T>;
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeAllocatorTraits = std::allocator_traits<NodeAllocator>;
+
+    Node* first = nullptr;
+    Node* last = nullptr;
+    size_t size = 0;
+    NodeAllocator allocator;
+
+    Node* createNode(const T& data, Node* prev, Node* next) {
+        Node* node = NodeAllocatorTraits::allocate(allocator, 1);
+        try {
+            NodeAllocatorTraits::construct(allocator, node, data, prev, next);
+        }
+        catch (...) {
+            NodeAllocatorTraits::deallocate(allocator, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    void destroyNode(Node* node) {
+        NodeAllocatorTraits::destroy(allocator, node);
+        NodeAllocatorTraits::deallocate(allocator, node, 1);
+    }
+
+    void copyToEmptyList(const DoublyLinkedList& list) {
+        for (Node* ptr = list.first; ptr; ptr = ptr->next)
+            pushBack(ptr->data);
+    }
+
+    // takes nodes of the list, which must be empty, the other list becomes empty
+    void stealNodes(DoublyLinkedList& list) {
+        first = list.first;
+        last = list.last;
+        size = list.size;
+        list.first = list.last = nullptr;
+        list.size = 0;
+    }
+
+    // links nodes [firstNode, lastNode] after prevNode (to the beginning if prevNode is nullptr)
+    void linkAfter(Node* prevNode, Node* firstNode, Node* lastNode) {
+        Node* nextNode = prevNode ? prevNode->next : first;
+        firstNode->prev = prevNode;
+        lastNode->next = nextNode;
+        (prevNode ? prevNode->next : first) = firstNode;
+        (nextNode ? nextNode->prev : last) = lastNode;
+    }
+
+    // unlinks nodes [firstNode, lastNode] from the list
+    void unlink(Node* firstNode, Node* lastNode) {
+        (firstNode->prev ? firstNode->prev->next : first) = lastNode->next;
+        (lastNode->next ? lastNode->next->prev : last) = firstNode->prev;
+    }
+
+public:
+
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef DoublyLinkedListIterator<T> iterator;
+    typedef DoublyLinkedListIterator<T, const T> const_iterator;
+
+    DoublyLinkedList() {}
+
+    explicit DoublyLinkedList(const Allocator& allocator) : allocator(allocator) {}
+
+    DoublyLinkedList(const DoublyLinkedList& list) :
+        allocator(NodeAllocatorTraits::select_on_container_copy_construction(list.allocator)) {
+        copyToEmptyList(list);
+    }
+
+    // nodes are taken without copying, the allocator is moved together with them
+    DoublyLinkedList(DoublyLinkedList&& list) noexcept : allocator(std::move(list.allocator)) {
+        stealNodes(list);
+    }
+
+    ~DoublyLinkedList() {
+        clear();
+    }
+
+    Node* getFirst() const {
+        return first;
+    }
+
+    Node* getLast() const {
+        return last;
+    }
+
+    size_t getSize() const {
+        return size;
+    }
+
+    iterator begin() {
+        return iterator(first);
+    }
+
+    iterator end() {
+        return iterator();
+    }
+
+    const_iterator begin() const {
+        return const_iterator(first);
+    }
+
+    const_iterator end() const {
+        return const_iterator();
+    }
+
+    DoublyLinkedList& operator=(const DoublyLinkedList& list) {
+        if (&list != this) {
+            clear();
+            copyToEmptyList(list);
+        }
+        return *this;
+    }
+
+    // nodes are taken if allocators are equal, otherwise elements are copied
+    DoublyLinkedList& operator=(DoublyLinkedList&& list) {
+        if (&list != this) {
+            clear();
+            if (allocator == list.allocator) {
+                stealNodes(list);
+            }
+            else {
+                copyToEmptyList(list);
+                list.clear();
+            }
+        }
+        return *this;
+    }
+
+    friend bool operator==(const DoublyLinkedList& list1, const DoublyLinkedList& list2) {
+        if (list1.size != list2.size) return false;
+        for (Node *ptr1 = list1.first, *ptr2 = list2.first; ptr1; ptr1 = ptr1->next, ptr2 = ptr2->next)
+            if (ptr1->data != ptr2->data) return false;
+        return true;
+    }
+
+    friend bool operator!=(const DoublyLinkedList& list1, const DoublyLinkedList& list2) {
+        return !(list1 == list2);
+    }
+
+    Node* pushFront(const T& data) {  // returns new node
+        return insertAfter(data, nullptr);
+    }
+
+    void popFront() {
+        if (!empty()) erase(first);
+    }
+
+    Node* pushBack(const T& data) {  // returns new node
+        return insertAfter(data, last);
+    }
+
+    void popBack() {  // O(1)
+        if (!empty()) erase(last);
+    }
+
+    Node* insertAfter(const T& data, Node* prevNode = nullptr) {  // returns new node
+        Node* node = createNode(data, nullptr, nullptr);
+        linkAfter(prevNode, node, node);
+        size++;
+        return node;
+    }
+
+    void eraseAfter(Node* prevNode = nullptr) {
+        Node* node = prevNode ? prevNode->next : first;
+        if (node) erase(node);
+    }
+
+    void erase(Node* node) {  // O(1)
+        unlink(node, node);
+        destroyNode(node);
+        size--;
+    }
+
+    // moves all nodes of the list after prevNode (to the beginning if prevNode is nullptr), O(1)
+    // lists must have equal allocators
+    void spliceAfter(Node* prevNode, DoublyLinkedList& list) {
+        if (&list == this || list.empty()) return;
+        spliceAfter(prevNode, list, list.first, list.last, list.size);
+    }
+
+    // moves nodes [firstNode, lastNode] of the list after prevNode, O(1)
+    // count is the number of moved nodes, prevNode must not be in the range
+    // lists must have equal allocators
+    void spliceAfter(Node* prevNode, DoublyLinkedList& list, Node* firstNode, Node* lastNode, size_t count) {
+        if (allocator != list.allocator)
+            throw "Lists with different allocators can't be spliced";
+        list.unlink(firstNode, lastNode);
+        list.size -= count;
+        linkAfter(prevNode, firstNode, lastNode);
+        size += count;
+    }
+
+    // moves every node to the front of list getList(data), nodes are relinked, O(n)
+    // lists must have equal allocators, this list becomes empty
+    template <class GetList>
+    void moveAllTo(GetList getList) {
+        while (first)
+            getList(first->data).spliceAfter(nullptr, *this, first, first, 1);
+    }
+
+    // returns pointer to data of the first node satisfying predicate or nullptr
+    template <class Predicate>
+    T* findFirst(Predicate predicate) {
+        for (Node* ptr = first; ptr; ptr = ptr->next)
+            if (predicate(ptr->data)) return &(ptr->data);
+        return nullptr;
+    }
+
+    // erases the first node satisfying predicate in one pass
+    // returns true if node was erased
+    template <class Predicate>
+    bool eraseFirst(Predicate predicate) {
+        for (Node* ptr = first; ptr; ptr = ptr->next)
+            if (predicate(ptr->data)) {
+                erase(ptr);
+                return true;
+            }
+        return false;
+    }
+
+    bool empty() const {
+        return first == nullptr;
+    }
+
+    void clear() {
+        while (first) popFront();
+        releaseUnusedMemory(allocator);  // whole slabs are freed if the pool is not shared
+    }
+
+    allocator_type getAllocator() const {
+        return allocator_type(allocator);
+    }
+
+    friend std::ostream& operator<<(std::ostream& ostr, const DoublyLinkedList& list) {
+        for (Node* ptr = list.getFirst(); ptr; ptr = ptr->next)
+            ostr << ptr->data << "; ";
+        ostr << std::endl;
+        return ostr;
+    }
+};
@@ -5,9 +5,10 @@
 // all cells of open addressing hash table contain some labels
 // it is necessary to determine if a cell with default key == 0 is empty or not
 // or to determine a cell is deleted or not
-template <class ElemType>
+// Pair is std::pair or HashedPair to keep the hash of the key in the cell
+template <class ElemType, class Pair = std::pair<KeyType, ElemType>>
 struct HashTableOpenAddressingCell {
-    std::pair<KeyType, ElemType> data;
+    Pair data;
     bool is_cell_empty = true;
     bool is_element_was_deleted = false;
 
@@ -16,19 +17,30 @@ struct HashTableOpenAddressingCell {
 
     HashTableOpenAddressingCell(const KeyType& first, const ElemType& second,
         bool flag1 = false, bool flag2 = false) :
-        data(std::pair<KeyType, ElemType>(first, second)),
+        data(first, second),
         is_cell_empty(flag1), is_element_was_deleted(flag2) {}
 };
 
 
 // class for a hash table with open addressing
-template <class ElemType>
+// with Pair = HashedPair<ElemType> hashes are not computed on repack
+// and keys are compared only if hashes are equal
+// with Statistics = HashTableStatisticsCollector probe lengths and repacks are counted
+// cells are allocated by Allocator rebound to cells
+// load factor, growth and the number of deleted cells which causes rehash are set by HashTablePolicy
+template <class ElemType, class Pair = std::pair<KeyType, ElemType>, class Statistics = NoHashTableStatistics,
+    class Allocator = std::allocator<std::pair<KeyType, ElemType>>>
 class HashTableOpenAddressing :
-    public HashTable<ElemType, HashTableOpenAddressingCell<ElemType>> {
+    public HashTable<ElemType, HashTableOpenAddressingCell<ElemType, Pair>, Statistics, Allocator>,
+    public StaticTableInterface<HashTableOpenAddressing<ElemType, Pair, Statistics, Allocator>, ElemType> {
 
 protected:
 
-    using BaseClass = HashTable<ElemType, HashTableOpenAddressingCell<ElemType>>;
+    using Cell = HashTableOpenAddressingCell<ElemType, Pair>;
+    using BaseClass = HashTable<ElemType, Cell, Statistics, Allocator>;
+    using Storage = typename BaseClass::Storage;
+
+    size_t tombstones = 0;  // cells of deleted elements
 
     // returns elements of probe sequence
     size_t getProbeSequenceElem(size_t hashValue, size_t i) {
@@ -36,46 +48,92 @@ protected:
         return (hashValue + i * i) & (storage.size() - 1);
     }
 
-    void repack() {
-        M += size_t(1);   // double the storage size
-        std::vector<HashTableOpenAddressingCell<ElemType>> tmp(getStorageSize(M));  // new storage
+    // moves the cell to an empty cell of its probe sequence
+    // returns the new cell or nullptr if empty cell was not found
+    Cell* placeCell(Cell& cell, uint32_t fullHashValue) {
+        size_t hashValue = reduceHash(fullHashValue);
+        for (size_t i = 0; i < storage.size(); ++i) {
+            size_t index = getProbeSequenceElem(hashValue, i);
+            if (storage[index].is_cell_empty) {
+                tombstones -= storage[index].is_element_was_deleted;
+                storage[index] = std::move(cell);
+                size++;
+                return &(storage[index]);
+            }
+        }
+        return nullptr;
+    }
+
+    // repacks table until the cell is placed
+    Cell* insertCell(Cell& cell, uint32_t fullHashValue) {
+        Cell* newCell;
+        while (!(newCell = placeCell(cell, fullHashValue)))
+            repack();
+        return newCell;
+    }
+
+    // existing elements are moved to the new storage of size 2^newM, deleted ones are dropped
+    // cached hashes are used if cells contain them
+    void rehash(size_t newM) {
+        typename Statistics::RepackScope repackScope(statistics());
+        M = newM;
+        Storage tmp(getStorageSize(M), storage.get_allocator());  // new storage
         std::swap(tmp, storage);
 
-        // insertion of all elements (existing and deleted) again
         size = 0;
+        tombstones = 0;
         for (size_t i = 0; i < tmp.size(); i++)
-            if (!tmp[i].is_cell_empty || tmp[i].is_element_was_deleted) {
-                insert(tmp[i].data.first, tmp[i].data.second);
-                auto insertedElem = findCell(tmp[i].data.first);
-                insertedElem->is_cell_empty = tmp[i].is_cell_empty;
-                insertedElem->is_element_was_deleted = tmp[i].is_element_was_deleted;
-            }
+            if (!tmp[i].is_cell_empty)
+                insertCell(tmp[i], getFullHash(tmp[i].data));
     }
 
-    HashTableOpenAddressingCell<ElemType>* findCell(const KeyType& key) {
-        size_t hashValue = hash(key);
+    void repack() {
+        rehash(M + hashTablePolicy.growthDeg);
+    }
+
+    // new hash parameter, cached hashes are recomputed and elements are rehashed without growth
+    void reseed() {
+        changeHashParameter();
+        for (Cell& cell : storage)
+            if (!cell.is_cell_empty) setCachedHash(cell.data, fullHash(cell.data.first));
+        rehash(M);
+    }
+
+    // rehash is needed before insertion because of deleted cells
+    bool hasManyTombstones() const {
+        return tombstones != 0 && tombstones >= size_t(hashTablePolicy.maxTombstoneFactor * storage.size());
+    }
+
+    Cell* findCell(const KeyType& key) {
+        uint32_t fullHashValue = fullHash(key);
+        size_t hashValue = reduceHash(fullHashValue);
 
         // looking for cell with key or empty cell
         // item does not exist if there is an empty cell in probe sequence
-        size_t cell = 0, i = 0;
-        for (; i < storage.size(); ++i) {
-            cell = getProbeSequenceElem(hashValue, i);
-            if (!storage[cell].is_element_was_deleted)  // skip deleted items
-                if (storage[cell].is_cell_empty || storage[cell].data.first == key) // cell is empty or key has been found
-                    break;
+        for (size_t i = 0; i < storage.size(); ++i) {
+            Cell& cell = storage[getProbeSequenceElem(hashValue, i)];
+            if (cell.is_element_was_deleted)  // skip deleted items
+                continue;
+            if (cell.is_cell_empty) {
+                statistics().recordSearch(false, i + 1);
+                return nullptr;
+            }
+            if (mayContainKey(cell.data, fullHashValue) && cell.data.first == key) {  // key has been found
+                statistics().recordSearch(true, i + 1);
+                return &cell;
+            }
         }
-
-        if (i == storage.size() || storage[cell].is_cell_empty
-            || storage[cell].is_element_was_deleted || storage[cell].data.first != key)
-            return nullptr;
-
-        return &(storage[cell]);
+        statistics().recordSearch(false, storage.size());
+        return nullptr;
     }
 
 public:
 
-    HashTableOpenAddressing(size_t M = START_STORAGE_SIZE_DEG_HASH_TABLE) :
-        BaseClass(M) {}
+    HashTableOpenAddressing(size_t M = START_STORAGE_SIZE_DEG_HASH_TABLE, const Allocator& allocator = Allocator()) :
+        BaseClass(M, allocator) {}
+
+    HashTableOpenAddressing(const HashTablePolicy& hashTablePolicy, const Allocator& allocator = Allocator()) :
+        BaseClass(hashTablePolicy, allocator) {}
 
     // search O(1) on the average
     std::pair<KeyType, ElemType>* find(const KeyType& key) {
@@ -86,32 +144,56 @@ public:
 
     // insertion O(1) on the average
     bool insert(const KeyType& key, const ElemType& elem) {
-        if (findCell(key)) return false;  // key already exists
-
-        // if table is almost full then repack
-        if (size >= size_t(MAX_FILL_FACTOR_HASH_TABLE * storage.size()))
-            repack();
+        return findOrInsert(key, elem).second;
+    }
 
-        size_t hashValue = hash(key);
+    // one pass of the probe sequence O(1) on the average
+    // the first empty or deleted cell of the sequence is remembered while the key is searched
+    std::pair<std::pair<KeyType, ElemType>*, bool> findOrInsert(const KeyType& key, const ElemType& elem) {
+        uint32_t fullHashValue = fullHash(key);
+        size_t hashValue = reduceHash(fullHashValue);
 
-        // looking for cell we can insert to
-        size_t cell = 0, i = 0;
+        Cell* freeCell = nullptr;
+        size_t i = 0;
         for (; i < storage.size(); ++i) {
-            cell = getProbeSequenceElem(hashValue, i);
-            if (storage[cell].is_cell_empty)  // if cell is empty
-                break;
+            Cell& cell = storage[getProbeSequenceElem(hashValue, i)];
+            if (cell.is_cell_empty) {
+                if (!freeCell) freeCell = &cell;
+                if (!cell.is_element_was_deleted) break;  // key does not exist
+            }
+            else if (mayContainKey(cell.data, fullHashValue) && cell.data.first == key) {  // key already exists
+                statistics().recordSearch(true, i + 1);
+                return std::make_pair(&(cell.data), false);
+            }
         }
-
-        if (i == storage.size()) {  // if table is full then repack and try again
-            repack();
-            return this->insert(key, elem);
+        size_t probeLength = std::min(i + 1, storage.size());
+        statistics().recordSearch(false, probeLength);
+        insertionsSinceReseed++;
+
+        // keys collide too much, the cell found before reseed is not valid
+        bool isReseeded = needsReseed(probeLength);
+        if (isReseeded) {
+            reseed();
+            fullHashValue = fullHash(key);
         }
 
-        // if empty cell was found
-        size++;
-        storage[cell] = HashTableOpenAddressingCell<ElemType>(key, elem);
+        Cell newCell(key, elem);
+        setCachedHash(newCell.data, fullHashValue);
 
-        return true;
+        // if table is almost full then repack, if it has many deleted cells then rehash to drop them
+        if (isReseeded || isOverloaded() || hasManyTombstones()) {
+            if (isOverloaded()) repack();
+            else if (!isReseeded) rehash(M);
+            freeCell = insertCell(newCell, fullHashValue);
+        }
+        else if (freeCell) {
+            tombstones -= freeCell->is_element_was_deleted;
+            *freeCell = std::move(newCell);
+            size++;
+        }
+        else freeCell = insertCell(newCell, fullHashValue);  // empty cell was not found, table is repacked
+
+        return std::make_pair(&(freeCell->data), true);
     }
 
     // erasing O(1) on the average
@@ -122,7 +204,33 @@ public:
         size--;
         cell->is_cell_empty = true;
         cell->is_element_was_deleted = true;
+        tombstones++;
         return true;
     }
 
+    void clear() {
+        BaseClass::clear();
+        tombstones = 0;
+    }
+
+    // flags and cached hashes of cells with elements are metadata, empty and deleted cells are slack
+    // elements of deleted cells keep their heap memory till the cell is reused or rehashed, it is counted
+    // O(storage size)
+    MemoryUsage getMemoryUsage() const {
+        MemoryUsage res;
+        res.addArray(storage.capacity(), size, sizeof(Cell), sizeof(std::pair<KeyType, ElemType>));
+        for (const Cell& cell : storage)
+            if (!cell.is_cell_empty || cell.is_element_was_deleted)
+                res.elementHeapBytes += getHeapBytes(cell.data.second);
+        return res;
+    }
+
+    // probe lengths and repacks are counted only with HashTableStatisticsCollector, O(storage size)
+    HashTableStatistics getStatistics() const {
+        HashTableStatistics res = BaseClass::getCommonStatistics();
+        for (const Cell& cell : storage)
+            res.tombstones += cell.is_element_was_deleted;
+        return res;
+    }
+
 };
@@ -1,78 +1,163 @@
 #pragma once
 #include "Table.h"
 #include "List.h"
+#include "UnrolledList.h"
+#include "SmallVectorBucket.h"
 
 
 // class for a hash table with separate chaining (cell is a list)
-template <class ElemType>
-class HashTableSeparateChaining : public HashTable<ElemType,
-    List<std::pair<KeyType, ElemType>>> {
+// Bucket is List, UnrolledList or SmallVectorBucket of pairs (key, element)
+// or of HashedPair to keep hashes of keys in cells
+// all buckets share one allocator (nodes of lists are allocated from one pool)
+// with Statistics = HashTableStatisticsCollector lengths of searches and repacks are counted
+// the array of buckets is allocated by Allocator, nodes are allocated by the allocator of buckets
+// load factor and growth are set by HashTablePolicy
+template <class ElemType, class Bucket = List<std::pair<KeyType, ElemType>>,
+    class Statistics = NoHashTableStatistics, class Allocator = std::allocator<std::pair<KeyType, ElemType>>>
+class HashTableSeparateChaining : public HashTable<ElemType, Bucket, Statistics, Allocator>,
+    public StaticTableInterface<HashTableSeparateChaining<ElemType, Bucket, Statistics, Allocator>, ElemType> {
 
 protected:
 
+    using Cell = typename Bucket::value_type;
+    using NodeAllocator = typename Bucket::allocator_type;
+    using BaseClass = HashTable<ElemType, Bucket, Statistics, Allocator>;
+    using Storage = typename BaseClass::Storage;
+
+    // copies of the allocator share the pool
+    NodeAllocator nodeAllocator;
+
+    // elements are moved to 2^newM new buckets without allocation and copying (nodes of lists are relinked)
+    void rehash(size_t newM) {
+        typename Statistics::RepackScope repackScope(statistics());
+        M = newM;
+        Storage tmp(getStorageSize(M), Bucket(nodeAllocator), storage.get_allocator());  // new storage
+        std::swap(tmp, storage);
+
+        for (Bucket& bucket : tmp)
+            bucket.moveAllTo([this](const Cell& cell) -> Bucket& {
+                return storage[reduceHash(getFullHash(cell))];
+            });
+    }
+
     // repack if table is almost filled
     void repack() {
-        M += size_t(1);   // double the storage size
-        std::vector<List<std::pair<KeyType, ElemType>>> tmp(getStorageSize(M));  // new storage
-        std::swap(tmp, storage);
+        rehash(M + hashTablePolicy.growthDeg);
+    }
 
-        // insertion of all elements again
-        size = 0;
-        for (size_t i = 0; i < tmp.size(); i++)
-            for (auto ptr = storage[i].getFirst(); ptr; ptr = ptr->next)
-                insert(ptr->data.first, ptr->data.second);
+    // new hash parameter, cached hashes are recomputed and elements are moved to new buckets without growth
+    void reseed() {
+        changeHashParameter();
+        for (Bucket& bucket : storage)
+            for (Cell& cell : bucket)
+                setCachedHash(cell, fullHash(cell.first));
+        rehash(M);
     }
 
-    using BaseClass = HashTable<ElemType, List<std::pair<KeyType, ElemType>>>;
+    // search in the chain, inspected elements are counted for statistics
+    Cell* findInBucket(Bucket& bucket, const KeyType& key, uint32_t fullHashValue) {
+        size_t probeLength = 0;
+        Cell* cell = bucket.findFirst([&key, fullHashValue, &probeLength](const Cell& cell) {
+            probeLength++;
+            return mayContainKey(cell, fullHashValue) && cell.first == key;
+        });
+        statistics().recordSearch(cell != nullptr, probeLength);
+        return cell;
+    }
 
 public:
 
-    HashTableSeparateChaining(size_t M = START_STORAGE_SIZE_DEG_HASH_TABLE) :
-        BaseClass(M) {}
-
-    // search O(1) on the average
-    std::pair<KeyType, ElemType>* find(const KeyType& key) override {
-        size_t hashValue = hash(key);
-        List<std::pair<KeyType, ElemType>>& cellList = storage[hashValue];
+    // buckets are copy constructed to share the allocator, assignment would keep their own ones
+    HashTableSeparateChaining(size_t M = START_STORAGE_SIZE_DEG_HASH_TABLE, const Allocator& allocator = Allocator(),
+        const NodeAllocator& nodeAllocator = NodeAllocator()) :
+        BaseClass(M, Bucket(nodeAllocator), allocator), nodeAllocator(nodeAllocator) {}
 
-        auto ptr = cellList.getFirst();
-        for (; ptr; ptr = ptr->next)
-            if (ptr->data.first == key) break;
+    HashTableSeparateChaining(const HashTablePolicy& hashTablePolicy, const Allocator& allocator = Allocator(),
+        const NodeAllocator& nodeAllocator = NodeAllocator()) :
+        BaseClass(hashTablePolicy, Bucket(nodeAllocator), allocator), nodeAllocator(nodeAllocator) {}
 
-        if (!ptr) return nullptr;
-        return &(ptr->data);
+    // search O(1) on the average
+    std::pair<KeyType, ElemType>* find(const KeyType& key) {
+        uint32_t fullHashValue = fullHash(key);
+        return findInBucket(storage[reduceHash(fullHashValue)], key, fullHashValue);
     }
 
     // insertion O(1) on the average
-    bool insert(const KeyType& key, const ElemType& elem) override {
-        if (find(key)) return false;  // key already exists
+    bool insert(const KeyType& key, const ElemType& elem) {
+        return findOrInsert(key, elem).second;
+    }
 
-        // if table is almost full then repack
-        if (size >= size_t(MAX_FILL_FACTOR_HASH_TABLE * storage.size()))
+    // one pass of the chain O(1) on the average
+    std::pair<std::pair<KeyType, ElemType>*, bool> findOrInsert(const KeyType& key, const ElemType& elem) {
+        uint32_t fullHashValue = fullHash(key);
+        Cell* cell = findInBucket(storage[reduceHash(fullHashValue)], key, fullHashValue);
+        if (cell) return std::make_pair(cell, false);  // key already exists
+        insertionsSinceReseed++;
+
+        // if keys collide too much then reseed, if table is almost full then repack
+        if (needsReseed(storage[reduceHash(fullHashValue)].getSize())) {
+            reseed();
+            fullHashValue = fullHash(key);
+        }
+        if (isOverloaded())
             repack();
 
-        size_t hashValue = hash(key);
-        storage[hashValue].pushFront(std::make_pair(key, elem));
+        Cell newCell(key, elem);
+        setCachedHash(newCell, fullHashValue);
+        Bucket& bucket = storage[reduceHash(fullHashValue)];
+        bucket.pushFront(std::move(newCell));
         size++;
 
-        return true;
+        return std::make_pair(&*bucket.begin(), true);  // new element is the first one in the bucket
     }
 
     // erasing O(1) on the average
-    bool erase(const KeyType& key) override {
-        if (!find(key)) return false;  // key does not exists
+    bool erase(const KeyType& key) {
+        uint32_t fullHashValue = fullHash(key);
+        size_t probeLength = 0;
+        bool isErased = bool(storage[reduceHash(fullHashValue)].eraseFirst(
+            [&key, fullHashValue, &probeLength](const Cell& cell) {
+                probeLength++;
+                return mayContainKey(cell, fullHashValue) && cell.first == key;
+            }));
+        statistics().recordSearch(isErased, probeLength);
+        if (!isErased) return false;  // key does not exists
 
-        size_t hashValue = hash(key);
-        List<std::pair<KeyType, ElemType>>& cellList = storage[hashValue];
+        size--;
+        return true;
+    }
 
-        auto ptr = cellList.getFirst();
-        Node<std::pair<KeyType, ElemType>>* prevPtr = nullptr;
-        for (; ptr; ptr = ptr->next)
-            if (ptr->data.first == key) break;
-            else prevPtr = ptr;
+    // the allocator of nodes is kept, whole slabs of the pool are freed
+    void clear() {
+        Storage(storage.get_allocator()).swap(storage);  // nodes are freed by buckets
+        releaseUnusedMemory(nodeAllocator);
+        size = 0;
+        M = hashTablePolicy.startStorageSizeDeg;
+        Storage(getStorageSize(M), Bucket(nodeAllocator), storage.get_allocator()).swap(storage);
+    }
 
-        storage[hashValue].eraseAfter(prevPtr);
-        size--;
+    // buckets are metadata, free slots of buckets and chunks are slack, O(storage size + n)
+    MemoryUsage getMemoryUsage() const {
+        MemoryUsage res;
+        res.arrayBytes = storage.capacity() * sizeof(Bucket);
+        res.slackBytes = (storage.capacity() - storage.size()) * sizeof(Bucket);
+        for (const Bucket& bucket : storage) {
+            res.nodeBytes += bucket.getAllocatedBytes();
+            res.slackBytes += (bucket.getCapacity() - bucket.getSize()) * sizeof(Cell);
+            for (const Cell& cell : bucket)
+                res.elementHeapBytes += getHeapBytes(cell.second);
+        }
+        res.elementBytes = size * sizeof(std::pair<KeyType, ElemType>);
+        res.metadataBytes = res.arrayBytes + res.nodeBytes - res.elementBytes - res.slackBytes;
+        return res;
+    }
+
+    // lengths of searches and repacks are counted only with HashTableStatisticsCollector, O(storage size)
+    HashTableStatistics getStatistics() const {
+        HashTableStatistics res = BaseClass::getCommonStatistics();
+        for (const Bucket& bucket : storage)
+            HashTableStatistics::addToHistogram(res.chainLengths, bucket.getSize());
+        return res;
     }
 
 };
@@ -0,0 +1,129 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+
+
+const size_t HISTOGRAM_SIZE_HASH_TABLE_STATISTICS = 32;  // the last bin counts all longer lengths
+
+
+// statistics of a hash table, it is returned by getStatistics() of hash tables
+// counters of searches and repacks are collected only by tables with HashTableStatisticsCollector,
+// the other fields are computed from the current state of the table
+struct HashTableStatistics {
+    bool collected = false;  // false if counters were not collected
+
+    // the number of searches by the number of inspected cells (or chain elements), 0..HISTOGRAM_SIZE-1
+    size_t hitProbeLengths[HISTOGRAM_SIZE_HASH_TABLE_STATISTICS] = {};
+    size_t missProbeLengths[HISTOGRAM_SIZE_HASH_TABLE_STATISTICS] = {};
+    size_t repackCount = 0;
+    double repackTimeNs = 0;
+    size_t reseedCount = 0;     // changes of the hash parameter because of long probes
+
+    size_t size = 0;
+    size_t storageSize = 0;     // number of cells or buckets
+    size_t storageBytes = 0;    // memory of the array of cells or buckets
+    double loadFactor = 0;
+    size_t tombstones = 0;      // deleted cells of open addressing
+    size_t chainLengths[HISTOGRAM_SIZE_HASH_TABLE_STATISTICS] = {};  // number of buckets by chain length
+
+    static void addToHistogram(size_t* histogram, size_t length) {
+        histogram[std::min(length, HISTOGRAM_SIZE_HASH_TABLE_STATISTICS - 1)]++;
+    }
+
+    friend std::ostream& operator<<(std::ostream& ostr, const HashTableStatistics& statistics) {
+        ostr << "size: " << statistics.size << ", storage size: " << statistics.storageSize
+            << ", load factor: " << statistics.loadFactor << ", storage bytes: " << statistics.storageBytes
+            << ", tombstones: " << statistics.tombstones << std::endl;
+        printHistogram(ostr, "chain lengths", statistics.chainLengths);
+        if (!statistics.collected) return ostr;
+        ostr << "repacks: " << statistics.repackCount << ", repack time: " << statistics.repackTimeNs / 1e6 << " ms"
+            << ", reseeds: " << statistics.reseedCount << std::endl;
+        printHistogram(ostr, "probe lengths of hits", statistics.hitProbeLengths);
+        printHistogram(ostr, "probe lengths of misses", statistics.missProbeLengths);
+        return ostr;
+    }
+
+private:
+
+    // non-zero bins as "length: count; ", the last one is "length+"
+    static void printHistogram(std::ostream& ostr, const char* name, const size_t* histogram) {
+        ostr << name << ": ";
+        for (size_t i = 0; i < HISTOGRAM_SIZE_HASH_TABLE_STATISTICS; i++)
+            if (histogram[i])
+                ostr << i << (i + 1 == HISTOGRAM_SIZE_HASH_TABLE_STATISTICS ? "+" : "") << ": " << histogram[i] << "; ";
+        ostr << std::endl;
+    }
+};
+
+
+// statistics policy of hash tables that collects nothing, its calls are removed by the compiler
+struct NoHashTableStatistics {
+
+    // the destructor is user-provided, so unused scope variables are not warned about
+    struct RepackScope {
+        RepackScope(NoHashTableStatistics&) {}
+        ~RepackScope() {}
+    };
+
+    void recordSearch(bool, size_t) {}
+    void recordReseed() {}
+    void exportTo(HashTableStatistics&) const {}
+    void reset() {}
+};
+
+
+// statistics policy of hash tables that counts probe lengths and time of repacks
+class HashTableStatisticsCollector {
+    size_t hitProbeLengths[HISTOGRAM_SIZE_HASH_TABLE_STATISTICS] = {};
+    size_t missProbeLengths[HISTOGRAM_SIZE_HASH_TABLE_STATISTICS] = {};
+    size_t repackCount = 0;
+    double repackTimeNs = 0;
+    size_t reseedCount = 0;
+    size_t repackDepth = 0;  // repack can be called from repack, time is counted once
+
+public:
+
+    // measures a repack from construction till destruction
+    class RepackScope {
+        HashTableStatisticsCollector& collector;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+
+        RepackScope(HashTableStatisticsCollector& collector) :
+            collector(collector), start(std::chrono::steady_clock::now()) {
+            collector.repackCount++;
+            collector.repackDepth++;
+        }
+
+        ~RepackScope() {
+            if (--collector.repackDepth == 0)
+                collector.repackTimeNs +=
+                    std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        }
+    };
+
+    // probeLength is the number of inspected cells or chain elements
+    void recordSearch(bool isHit, size_t probeLength) {
+        HashTableStatistics::addToHistogram(isHit ? hitProbeLengths : missProbeLengths, probeLength);
+    }
+
+    void recordReseed() {
+        reseedCount++;
+    }
+
+    void exportTo(HashTableStatistics& statistics) const {
+        statistics.collected = true;
+        std::copy(hitProbeLengths, hitProbeLengths + HISTOGRAM_SIZE_HASH_TABLE_STATISTICS, statistics.hitProbeLengths);
+        std::copy(missProbeLengths, missProbeLengths + HISTOGRAM_SIZE_HASH_TABLE_STATISTICS, statistics.missProbeLengths);
+        statistics.repackCount = repackCount;
+        statistics.repackTimeNs = repackTimeNs;
+        statistics.reseedCount = reseedCount;
+    }
+
+    void reset() {
+        *this = HashTableStatisticsCollector();
+    }
+};
@@ -0,0 +1,165 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+
+const size_t MAX_THREADS_HAZARD_POINTERS = 128;
+const size_t HAZARD_POINTERS_PER_THREAD = 2;
+// retired pointers are checked against hazard pointers when there are more of them than this number,
+// so reclamation is O(1) per retired pointer on the average
+const size_t SCAN_THRESHOLD_HAZARD_POINTERS = 2 * MAX_THREADS_HAZARD_POINTERS * HAZARD_POINTERS_PER_THREAD;
+
+
+// safe memory reclamation for lock-free containers (M. Michael, 2004)
+// a thread publishes pointers it is going to dereference in its hazard pointers,
+// removed nodes are retired and deleted only when no hazard pointer points to them
+// up to MAX_THREADS_HAZARD_POINTERS threads may use hazard pointers at the same time
+class HazardPointers {
+
+    struct RetiredPointer {
+        void* pointer;
+        void (*deleter)(void*);
+    };
+
+    struct Record {
+        std::atomic<bool> owned{ false };
+        std::atomic<void*> hazards[HAZARD_POINTERS_PER_THREAD];
+    };
+
+    // records of all threads and pointers retired by finished threads
+    class Domain {
+        Record records[MAX_THREADS_HAZARD_POINTERS];
+        std::mutex orphansMutex;
+        std::vector<RetiredPointer> orphans;
+
+    public:
+
+        Domain() {
+            for (Record& record : records)
+                for (std::atomic<void*>& hazard : record.hazards)
+                    hazard.store(nullptr);
+        }
+
+        ~Domain() {
+            for (RetiredPointer& retired : orphans)
+                retired.deleter(retired.pointer);
+        }
+
+        Record* acquireRecord() {
+            for (Record& record : records) {
+                bool owned = false;
+                if (!record.owned.load() && record.owned.compare_exchange_strong(owned, true))
+                    return &record;
+            }
+            throw "Too many threads use hazard pointers";
+        }
+
+        // deletes retired pointers which are not hazardous, the others are left in the vector
+        void scan(std::vector<RetiredPointer>& retired) {
+            {
+                std::unique_lock<std::mutex> lock(orphansMutex, std::try_to_lock);
+                if (lock.owns_lock() && !orphans.empty()) {
+                    retired.insert(retired.end(), orphans.begin(), orphans.end());
+                    orphans.clear();
+                }
+            }
+
+            std::vector<void*> hazards;
+            for (Record& record : records)
+                for (std::atomic<void*>& hazard : record.hazards) {
+                    void* pointer = hazard.load();
+                    if (pointer) hazards.push_back(pointer);
+                }
+            std::sort(hazards.begin(), hazards.end());
+
+            size_t kept = 0;
+            for (RetiredPointer& pointer : retired)
+                if (std::binary_search(hazards.begin(), hazards.end(), pointer.pointer))
+                    retired[kept++] = pointer;
+                else
+                    pointer.deleter(pointer.pointer);
+            retired.resize(kept);
+        }
+
+        void addOrphans(const std::vector<RetiredPointer>& retired) {
+            std::lock_guard<std::mutex> lock(orphansMutex);
+            orphans.insert(orphans.end(), retired.begin(), retired.end());
+        }
+    };
+
+    // record of the current thread, it is given back when the thread finishes
+    struct ThreadState {
+        Record* record;
+        std::vector<RetiredPointer> retired;
+
+        ThreadState() : record(getDomain().acquireRecord()) {}
+
+        ~ThreadState() {
+            for (std::atomic<void*>& hazard : record->hazards)
+                hazard.store(nullptr);
+            getDomain().scan(retired);
+            if (!retired.empty()) getDomain().addOrphans(retired);
+            record->owned.store(false);
+        }
+    };
+
+    static Domain& getDomain() {
+        static Domain domain;
+        return domain;
+    }
+
+    static ThreadState& getThreadState() {
+        static thread_local ThreadState state;
+        return state;
+    }
+
+    template <class T>
+    static void deletePointer(void* pointer) {
+        delete static_cast<T*>(pointer);
+    }
+
+public:
+
+    // the pointer will not be deleted until the slot is cleared or reused
+    // it must be checked that the pointer is still reachable after setting
+    static void set(size_t slot, void* pointer) {
+        getThreadState().record->hazards[slot].store(pointer);
+    }
+
+    static void clear(size_t slot) {
+        getThreadState().record->hazards[slot].store(nullptr);
+    }
+
+    // reads the pointer from source and sets hazard pointer to it
+    // returns the pointer, which can be dereferenced until the slot is cleared
+    template <class T>
+    static T* protect(size_t slot, const std::atomic<T*>& source) {
+        T* pointer = source.load();
+        while (true) {
+            set(slot, pointer);
+            T* current = source.load();
+            if (current == pointer) return pointer;
+            pointer = current;
+        }
+    }
+
+    // pointer removed from a container is deleted when no thread protects it
+    template <class T>
+    static void retire(T* pointer) {
+        ThreadState& state = getThreadState();
+        state.retired.push_back(RetiredPointer{ pointer, &deletePointer<T> });
+        if (state.retired.size() > SCAN_THRESHOLD_HAZARD_POINTERS)
+            getDomain().scan(state.retired);
+    }
+
+    // deletes pointers retired by the current thread if they are not protected
+    // returns the number of pointers that are still waiting
+    static size_t reclaim() {
+        ThreadState& state = getThreadState();
+        getDomain().scan(state.retired);
+        return state.retired.size();
+    }
+};
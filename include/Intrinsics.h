@@ -0,0 +1,125 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// SSE2 is a part of every x86-64 target, AVX2 has to be enabled by compiler flags
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DATA_STRUCTURES_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define DATA_STRUCTURES_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define DATA_STRUCTURES_X86
+#if !defined(_MSC_VER)
+#include <x86intrin.h>
+#endif
+#endif
+
+
+// index of the lowest set bit, value must not be 0
+inline unsigned countTrailingZeros(uint32_t value) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return (unsigned)index;
+#else
+    return (unsigned)__builtin_ctz(value);
+#endif
+}
+
+// index of the lowest set bit, value must not be 0
+inline unsigned countTrailingZeros(uint64_t value) {
+#if defined(_MSC_VER)
+    if (uint32_t(value)) return countTrailingZeros(uint32_t(value));
+    return 32 + countTrailingZeros(uint32_t(value >> 32));
+#else
+    return (unsigned)__builtin_ctzll(value);
+#endif
+}
+
+// index of the highest set bit, value must not be 0
+inline unsigned getHighestBitIndex(uint64_t value) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    if (value >> 32) {
+        _BitScanReverse(&index, uint32_t(value >> 32));
+        return 32 + (unsigned)index;
+    }
+    _BitScanReverse(&index, uint32_t(value));
+    return (unsigned)index;
+#else
+    return 63 - (unsigned)__builtin_clzll(value);
+#endif
+}
+
+#if defined(DATA_STRUCTURES_X86)
+// value of the time stamp counter, it grows with a constant rate on modern processors
+inline uint64_t readTimestampCounter() {
+    return __rdtsc();
+}
+#endif
+
+// number of set bits
+inline unsigned popCount(uint64_t value) {
+#if defined(_MSC_VER)
+    value = value - ((value >> 1) & 0x5555555555555555ull);
+    value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+    value = (value + (value >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return unsigned((value * 0x0101010101010101ull) >> 56);
+#else
+    return (unsigned)__builtin_popcountll(value);
+#endif
+}
+
+// number of elements compared by one iteration of findFirstEqual
+const size_t FIND_FIRST_EQUAL_BLOCK_SIZE = 16;
+
+// returns index of the first element equal to value, n if there is no such element
+// compares 8 (AVX2) or 4 (SSE2) elements per instruction
+// values must be readable up to n rounded up to a multiple of FIND_FIRST_EQUAL_BLOCK_SIZE
+inline size_t findFirstEqual(const uint32_t* values, size_t n, uint32_t value) {
+#if defined(DATA_STRUCTURES_AVX2)
+    const __m256i pattern = _mm256_set1_epi32((int)value);
+    for (size_t i = 0; i < n; i += FIND_FIRST_EQUAL_BLOCK_SIZE) {
+        __m256i cmp1 = _mm256_cmpeq_epi32(pattern, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+        __m256i cmp2 = _mm256_cmpeq_epi32(pattern, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + 8)));
+        uint32_t mask = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(cmp1))
+            | ((uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(cmp2)) << 8);
+        if (mask) {
+            size_t index = i + countTrailingZeros(mask);
+            return index < n ? index : n;
+        }
+    }
+    return n;
+#elif defined(DATA_STRUCTURES_SSE2)
+    const __m128i pattern = _mm_set1_epi32((int)value);
+    for (size_t i = 0; i < n; i += FIND_FIRST_EQUAL_BLOCK_SIZE) {
+        __m128i cmp1 = _mm_cmpeq_epi32(pattern, _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)));
+        __m128i cmp2 = _mm_cmpeq_epi32(pattern, _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i + 4)));
+        __m128i cmp3 = _mm_cmpeq_epi32(pattern, _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i + 8)));
+        __m128i cmp4 = _mm_cmpeq_epi32(pattern, _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i + 12)));
+        uint32_t mask = (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(cmp1))
+            | ((uint32_t)_mm_movemask_ps(_mm_castsi128_ps(cmp2)) << 4)
+            | ((uint32_t)_mm_movemask_ps(_mm_castsi128_ps(cmp3)) << 8)
+            | ((uint32_t)_mm_movemask_ps(_mm_castsi128_ps(cmp4)) << 12);
+        if (mask) {
+            size_t index = i + countTrailingZeros(mask);
+            return index < n ? index : n;
+        }
+    }
+    return n;
+#else
+    for (size_t i = 0; i < n; i++)
+        if (values[i] == value) return i;
+    return n;
+#endif
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include "Table.h"
+#include "IntrusiveList.h"
+
+
+// key of an object is its member
+template <class T, KeyType T::*Member>
+struct MemberKey {
+    KeyType operator()(const T& object) const {
+        return object.*Member;
+    }
+};
+
+
+// hash table with separate chaining for objects owned by the user
+// objects are linked into buckets by their hooks, so insertion and erasing don't allocate memory
+// (only the storage of buckets is reallocated when the table is repacked)
+// KeyOf returns key of an object, keys must not be changed while objects are in the table
+template <class T, class KeyOf, class HookAccess = BaseHookAccess<T, IntrusiveListHook<T>>>
+class IntrusiveHashTable : public HashFunction {
+
+    using Bucket = IntrusiveList<T, HookAccess>;
+
+    std::vector<Bucket> storage;
+    size_t size = 0;
+    KeyOf keyOf;
+
+    // objects are relinked to new buckets
+    void repack() {
+        M += size_t(1);   // double the storage size
+        std::vector<Bucket> tmp(getStorageSize(M));
+        std::swap(tmp, storage);
+
+        for (Bucket& bucket : tmp)
+            while (!bucket.empty()) {
+                T* object = bucket.getFirst();
+                bucket.popFront();
+                storage[hash(keyOf(*object))].pushFront(*object);
+            }
+    }
+
+public:
+
+    IntrusiveHashTable(size_t M = START_STORAGE_SIZE_DEG_HASH_TABLE, KeyOf keyOf = KeyOf()) :
+        HashFunction(M), storage(getStorageSize(M)), keyOf(keyOf) {}
+
+    IntrusiveHashTable(const IntrusiveHashTable&) = delete;
+    IntrusiveHashTable& operator=(const IntrusiveHashTable&) = delete;
+
+    // search O(1) on the average
+    // returns nullptr if object was not found
+    T* find(const KeyType& key) {
+        return storage[hash(key)].findFirst([this, &key](const T& object) { return keyOf(object) == key; });
+    }
+
+    // links the object into the table, O(1) on the average
+    // returns false if object with the same key already exists, the object is not linked then
+    bool insert(T& object) {
+        KeyType key = keyOf(object);
+        if (find(key)) return false;  // key already exists
+
+        // if table is almost full then repack
+        if (size >= size_t(MAX_FILL_FACTOR_HASH_TABLE * storage.size()))
+            repack();
+
+        storage[hash(key)].pushFront(object);
+        size++;
+
+        return true;
+    }
+
+    // unlinks the object with the key, O(1) on the average
+    // returns the object or nullptr if key does not exist
+    T* erase(const KeyType& key) {
+        T* object = storage[hash(key)].eraseFirst(
+            [this, &key](const T& object) { return keyOf(object) == key; });
+        if (object) size--;
+        return object;
+    }
+
+    // unlinks all objects
+    void clear() {
+        for (Bucket& bucket : storage)
+            bucket.clear();
+        M = START_STORAGE_SIZE_DEG_HASH_TABLE;
+        std::vector<Bucket> tmp(getStorageSize(M));
+        std::swap(tmp, storage);
+        size = 0;
+    }
+
+    size_t getSize() const {
+        return size;
+    }
+
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+};
@@ -0,0 +1,350 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+
+// links of intrusive lists are stored inside of the objects, so lists don't allocate memory
+// an object type contains a hook as a base class or as a member,
+// one object can be in several lists at once if it has several hooks
+// lists don't own objects, objects must be erased from a list before their destruction,
+// destructor of a list doesn't touch objects
+// copy of a hook is not linked, so copying objects doesn't break lists
+
+template <class T>
+struct IntrusiveListHook {
+    T* next = nullptr;
+
+    IntrusiveListHook() {}
+    IntrusiveListHook(const IntrusiveListHook&) {}
+    IntrusiveListHook& operator=(const IntrusiveListHook&) { return *this; }
+};
+
+template <class T>
+struct IntrusiveDoublyLinkedListHook {
+    T* prev = nullptr;
+    T* next = nullptr;
+
+    IntrusiveDoublyLinkedListHook() {}
+    IntrusiveDoublyLinkedListHook(const IntrusiveDoublyLinkedListHook&) {}
+    IntrusiveDoublyLinkedListHook& operator=(const IntrusiveDoublyLinkedListHook&) { return *this; }
+};
+
+
+// hook is a base class of T
+template <class T, class Hook>
+struct BaseHookAccess {
+    static Hook& get(T& object) {
+        return object;
+    }
+};
+
+// hook is a member of T
+template <class T, class Hook, Hook T::*Member>
+struct MemberHookAccess {
+    static Hook& get(T& object) {
+        return object.*Member;
+    }
+};
+
+
+// forward iterator over objects of an intrusive list, Value is T or const T
+template <class T, class HookAccess, class Value = T>
+class IntrusiveListIterator {
+    T* object;
+
+public:
+
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Value* pointer;
+    typedef Value& reference;
+
+    IntrusiveListIterator(T* object = nullptr) : object(object) {}
+
+    operator IntrusiveListIterator<T, HookAccess, const T>() const {
+        return IntrusiveListIterator<T, HookAccess, const T>(object);
+    }
+
+    Value& operator*() const {
+        return *object;
+    }
+
+    Value* operator->() const {
+        return object;
+    }
+
+    IntrusiveListIterator& operator++() {
+        object = HookAccess::get(*object).next;
+        return *this;
+    }
+
+    IntrusiveListIterator operator++(int) {
+        IntrusiveListIterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    friend bool operator==(const IntrusiveListIterator& it1, const IntrusiveListIterator& it2) {
+        return it1.object == it2.object;
+    }
+
+    friend bool operator!=(const IntrusiveListIterator& it1, const IntrusiveListIterator& it2) {
+        return it1.object != it2.object;
+    }
+};
+
+
+// singly linked intrusive list, interface is the same as of List, but objects are linked instead of copied
+template <class T, class HookAccess = BaseHookAccess<T, IntrusiveListHook<T>>>
+class IntrusiveList {
+    T* first = nullptr;
+    size_t size = 0;
+
+    static T*& next(T* object) {
+        return HookAccess::get(*object).next;
+    }
+
+public:
+
+    typedef IntrusiveListIterator<T, HookAccess> iterator;
+    typedef IntrusiveListIterator<T, HookAccess, const T> const_iterator;
+
+    IntrusiveList() {}
+    IntrusiveList(const IntrusiveList&) = delete;
+    IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+    IntrusiveList(IntrusiveList&& list) noexcept : first(list.first), size(list.size) {
+        list.first = nullptr;
+        list.size = 0;
+    }
+
+    IntrusiveList& operator=(IntrusiveList&& list) noexcept {
+        if (&list != this) {
+            clear();
+            std::swap(first, list.first);
+            std::swap(size, list.size);
+        }
+        return *this;
+    }
+
+    T* getFirst() const {
+        return first;
+    }
+
+    size_t getSize() const {
+        return size;
+    }
+
+    iterator begin() {
+        return iterator(first);
+    }
+
+    iterator end() {
+        return iterator();
+    }
+
+    const_iterator begin() const {
+        return const_iterator(first);
+    }
+
+    const_iterator end() const {
+        return const_iterator();
+    }
+
+    void pushFront(T& object) {
+        next(&object) = first;
+        first = &object;
+        size++;
+    }
+
+    void popFront() {
+        if (empty()) return;
+        T* object = first;
+        first = next(object);
+        next(object) = nullptr;
+        size--;
+    }
+
+    void insertAfter(T& object, T* prevObject = nullptr) {
+        if (!prevObject) {
+            pushFront(object);
+            return;
+        }
+        next(&object) = next(prevObject);
+        next(prevObject) = &object;
+        size++;
+    }
+
+    void eraseAfter(T* prevObject = nullptr) {
+        if (!prevObject) {
+            popFront();
+            return;
+        }
+        T* object = next(prevObject);
+        if (!object) return;
+        next(prevObject) = next(object);
+        next(object) = nullptr;
+        size--;
+    }
+
+    // returns the first object satisfying predicate or nullptr
+    template <class Predicate>
+    T* findFirst(Predicate predicate) {
+        for (T* ptr = first; ptr; ptr = next(ptr))
+            if (predicate(*ptr)) return ptr;
+        return nullptr;
+    }
+
+    // unlinks the first object satisfying predicate in one pass
+    // returns the object or nullptr
+    template <class Predicate>
+    T* eraseFirst(Predicate predicate) {
+        T* prevPtr = nullptr;
+        for (T* ptr = first; ptr; prevPtr = ptr, ptr = next(ptr))
+            if (predicate(*ptr)) {
+                eraseAfter(prevPtr);
+                return ptr;
+            }
+        return nullptr;
+    }
+
+    bool empty() const {
+        return first == nullptr;
+    }
+
+    // objects are unlinked, not destroyed
+    void clear() {
+        while (first) popFront();
+    }
+};
+
+
+// doubly linked intrusive list, every object can be unlinked in O(1)
+template <class T, class HookAccess = BaseHookAccess<T, IntrusiveDoublyLinkedListHook<T>>>
+class IntrusiveDoublyLinkedList {
+    T* first = nullptr;
+    T* last = nullptr;
+    size_t size = 0;
+
+    static T*& next(T* object) {
+        return HookAccess::get(*object).next;
+    }
+
+    static T*& prev(T* object) {
+        return HookAccess::get(*object).prev;
+    }
+
+public:
+
+    typedef IntrusiveListIterator<T, HookAccess> iterator;
+    typedef IntrusiveListIterator<T, HookAccess, const T> const_iterator;
+
+    IntrusiveDoublyLinkedList() {}
+    IntrusiveDoublyLinkedList(const IntrusiveDoublyLinkedList&) = delete;
+    IntrusiveDoublyLinkedList& operator=(const IntrusiveDoublyLinkedList&) = delete;
+
+    IntrusiveDoublyLinkedList(IntrusiveDoublyLinkedList&& list) noexcept :
+        first(list.first), last(list.last), size(list.size) {
+        list.first = list.last = nullptr;
+        list.size = 0;
+    }
+
+    IntrusiveDoublyLinkedList& operator=(IntrusiveDoublyLinkedList&& list) noexcept {
+        if (&list != this) {
+            clear();
+            std::swap(first, list.first);
+            std::swap(last, list.last);
+            std::swap(size, list.size);
+        }
+        return *this;
+    }
+
+    T* getFirst() const {
+        return first;
+    }
+
+    T* getLast() const {
+        return last;
+    }
+
+    size_t getSize() const {
+        return size;
+    }
+
+    iterator begin() {
+        return iterator(first);
+    }
+
+    iterator end() {
+        return iterator();
+    }
+
+    const_iterator begin() const {
+        return const_iterator(first);
+    }
+
+    const_iterator end() const {
+        return const_iterator();
+    }
+
+    void pushFront(T& object) {
+        insertAfter(object, nullptr);
+    }
+
+    void popFront() {
+        if (!empty()) erase(*first);
+    }
+
+    void pushBack(T& object) {
+        insertAfter(object, last);
+    }
+
+    void popBack() {
+        if (!empty()) erase(*last);
+    }
+
+    void insertAfter(T& object, T* prevObject = nullptr) {
+        T* nextObject = prevObject ? next(prevObject) : first;
+        prev(&object) = prevObject;
+        next(&object) = nextObject;
+        (prevObject ? next(prevObject) : first) = &object;
+        (nextObject ? prev(nextObject) : last) = &object;
+        size++;
+    }
+
+    // the object must be in this list, O(1)
+    void erase(T& object) {
+        (prev(&object) ? next(prev(&object)) : first) = next(&object);
+        (next(&object) ? prev(next(&object)) : last) = prev(&object);
+        prev(&object) = next(&object) = nullptr;
+        size--;
+    }
+
+    // returns the first object satisfying predicate or nullptr
+    template <class Predicate>
+    T* findFirst(Predicate predicate) {
+        for (T* ptr = first; ptr; ptr = next(ptr))
+            if (predicate(*ptr)) return ptr;
+        return nullptr;
+    }
+
+    // unlinks the first object satisfying predicate in one pass
+    // returns the object or nullptr
+    template <class Predicate>
+    T* eraseFirst(Predicate predicate) {
+        T* object = findFirst(predicate);
+        if (object) erase(*object);
+        return object;
+    }
+
+    bool empty() const {
+        return first == nullptr;
+    }
+
+    // objects are unlinked, not destroyed
+    void clear() {
+        while (first) popFront();
+    }
+};
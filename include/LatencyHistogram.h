@@ -0,0 +1,408 @@
+#pragma once
+#include "Table.h"
+#include "Intrinsics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+// percentiles of latencies of single operations, ns
+struct LatencySummary {
+    double p50 = 0, p90 = 0, p99 = 0, p999 = 0, max = 0;
+};
+
+
+const unsigned SUB_BIN_BITS_LATENCY_HISTOGRAM = 5;
+const size_t SUB_BINS_LATENCY_HISTOGRAM = size_t(1) << SUB_BIN_BITS_LATENCY_HISTOGRAM;
+const size_t BINS_LATENCY_HISTOGRAM = (64 - SUB_BIN_BITS_LATENCY_HISTOGRAM + 1) * SUB_BINS_LATENCY_HISTOGRAM;
+
+// log-linear histogram of values (HDR-style)
+// values less than 32 are counted exactly, every power of two above is divided into 32 bins,
+// so a value is known with the relative error less than 1/32, recording is O(1) without allocations
+// one thread records values, other threads can read or merge the histogram at the same time
+class LatencyHistogram {
+    std::atomic<uint64_t> counts[BINS_LATENCY_HISTOGRAM];
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> max;
+
+    // there is one writer, so read-modify-write instructions are not needed
+    static void add(std::atomic<uint64_t>& counter, uint64_t value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+public:
+
+    LatencyHistogram() {
+        reset();
+    }
+
+    LatencyHistogram(const LatencyHistogram& histogram) {
+        reset();
+        merge(histogram);
+    }
+
+    LatencyHistogram& operator=(const LatencyHistogram& histogram) {
+        if (&histogram != this) {
+            reset();
+            merge(histogram);
+        }
+        return *this;
+    }
+
+    static size_t getBinIndex(uint64_t value) {
+        if (value < SUB_BINS_LATENCY_HISTOGRAM) return size_t(value);
+        unsigned shift = getHighestBitIndex(value) - SUB_BIN_BITS_LATENCY_HISTOGRAM;
+        return (shift + 1) * SUB_BINS_LATENCY_HISTOGRAM + size_t(value >> shift) - SUB_BINS_LATENCY_HISTOGRAM;
+    }
+
+    // the lowest value counted in the bin
+    static uint64_t getBinLowest(size_t index) {
+        if (index < SUB_BINS_LATENCY_HISTOGRAM) return index;
+        unsigned shift = unsigned(index / SUB_BINS_LATENCY_HISTOGRAM) - 1;
+        return uint64_t(index % SUB_BINS_LATENCY_HISTOGRAM + SUB_BINS_LATENCY_HISTOGRAM) << shift;
+    }
+
+    // the highest value counted in the bin
+    static uint64_t getBinHighest(size_t index) {
+        return index + 1 == BINS_LATENCY_HISTOGRAM ? UINT64_MAX : getBinLowest(index + 1) - 1;
+    }
+
+    // must be called by one thread only
+    void record(uint64_t value) {
+        add(counts[getBinIndex(value)], 1);
+        add(count, 1);
+        if (value > max.load(std::memory_order_relaxed))
+            max.store(value, std::memory_order_relaxed);
+    }
+
+    // adds counts of other histogram, this histogram must not be recorded at the same time
+    void merge(const LatencyHistogram& histogram) {
+        for (size_t i = 0; i < BINS_LATENCY_HISTOGRAM; i++)
+            add(counts[i], histogram.counts[i].load(std::memory_order_relaxed));
+        add(count, histogram.count.load(std::memory_order_relaxed));
+        max.store(std::max(getMax(), histogram.getMax()), std::memory_order_relaxed);
+    }
+
+    void reset() {
+        for (std::atomic<uint64_t>& binCount : counts)
+            binCount.store(0, std::memory_order_relaxed);
+        count.store(0, std::memory_order_relaxed);
+        max.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t getCount() const {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    uint64_t getMax() const {
+        return max.load(std::memory_order_relaxed);
+    }
+
+    uint64_t getBinCount(size_t index) const {
+        return counts[index].load(std::memory_order_relaxed);
+    }
+
+    // the highest value of the bin where the percentile is, percentile is in [0, 1]
+    // returns 0 if histogram is empty
+    uint64_t getValueAtPercentile(double percentile) const {
+        uint64_t total = getCount();
+        if (total == 0) return 0;
+        uint64_t rank = std::max<uint64_t>(1, uint64_t(percentile * total + 0.5));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BINS_LATENCY_HISTOGRAM; i++) {
+            seen += getBinCount(i);
+            if (seen >= rank) return std::min(getBinHighest(i), getMax());
+        }
+        return getMax();
+    }
+
+    LatencySummary getSummary() const {
+        LatencySummary summary;
+        summary.p50 = double(getValueAtPercentile(0.5));
+        summary.p90 = double(getValueAtPercentile(0.9));
+        summary.p99 = double(getValueAtPercentile(0.99));
+        summary.p999 = double(getValueAtPercentile(0.999));
+        summary.max = double(getMax());
+        return summary;
+    }
+
+    // percentiles and non-empty bins as "lowest..highest: count; "
+    friend std::ostream& operator<<(std::ostream& ostr, const LatencyHistogram& histogram) {
+        LatencySummary summary = histogram.getSummary();
+        ostr << "count: " << histogram.getCount() << ", p50: " << summary.p50 << ", p99: " << summary.p99
+            << ", p99.9: " << summary.p999 << ", max: " << summary.max << std::endl;
+        for (size_t i = 0; i < BINS_LATENCY_HISTOGRAM; i++)
+            if (histogram.getBinCount(i))
+                ostr << getBinLowest(i) << ".." << getBinHighest(i) << ": " << histogram.getBinCount(i) << "; ";
+        ostr << std::endl;
+        return ostr;
+    }
+};
+
+
+// cheap clock for latencies: the time stamp counter on x86, steady_clock elsewhere
+inline uint64_t readTimestamp() {
+#if defined(DATA_STRUCTURES_X86)
+    return readTimestampCounter();
+#else
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// ns per unit of readTimestamp, it is measured by steady_clock once (for about 1 ms)
+inline double getNsPerTimestamp() {
+    static const double nsPerTimestamp = []() {
+#if defined(DATA_STRUCTURES_X86)
+        auto start = std::chrono::steady_clock::now();
+        uint64_t startTimestamp = readTimestamp();
+        std::chrono::steady_clock::time_point end;
+        do {
+            end = std::chrono::steady_clock::now();
+        } while (end - start < std::chrono::milliseconds(1));
+        uint64_t timestamps = readTimestamp() - startTimestamp;
+        double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        return timestamps ? ns / timestamps : 1.0;
+#else
+        return 1.0;
+#endif
+    }();
+    return nsPerTimestamp;
+}
+
+
+// operations whose latencies are recorded by InstrumentedTable
+enum class TableOperation { FIND, INSERT, ERASE, FIND_OR_INSERT, COUNT };
+
+inline const char* getName(TableOperation operation) {
+    switch (operation) {
+    case TableOperation::FIND: return "find";
+    case TableOperation::INSERT: return "insert";
+    case TableOperation::ERASE: return "erase";
+    default: return "findOrInsert";
+    }
+}
+
+// histograms of one thread
+struct ThreadLatencies {
+    std::thread::id thread;
+    LatencyHistogram histograms[size_t(TableOperation::COUNT)];
+    size_t skipped = 0;  // operations till the next measured one
+};
+
+// ids are not reused, so a cached pointer of a destroyed table is never taken
+inline uint64_t getNextInstrumentedTableId() {
+    static std::atomic<uint64_t> id(0);
+    return ++id;
+}
+
+// ids of existing instrumented tables, caches of threads drop the other ids
+inline std::mutex& getInstrumentedTableIdsMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+inline std::unordered_set<uint64_t>& getInstrumentedTableIds() {
+    static std::unordered_set<uint64_t> ids;
+    return ids;
+}
+
+// histograms of tables used by the thread, by ids of tables
+// it is read and changed only by its thread, so searches in it take no locks
+struct ThreadLatenciesCache {
+    std::unordered_map<uint64_t, ThreadLatencies*> tables;
+    size_t pruneSize = 16;  // destroyed tables are removed when the cache reaches this size
+
+    void add(uint64_t id, ThreadLatencies* latencies) {
+        if (tables.size() >= pruneSize) {
+            std::lock_guard<std::mutex> lock(getInstrumentedTableIdsMutex());
+            const std::unordered_set<uint64_t>& ids = getInstrumentedTableIds();
+            for (auto it = tables.begin(); it != tables.end();)
+                it = ids.count(it->first) ? std::next(it) : tables.erase(it);
+            pruneSize = std::max<size_t>(16, 2 * tables.size());
+        }
+        tables[id] = latencies;
+    }
+};
+
+inline ThreadLatenciesCache& getThreadLatenciesCache() {
+    thread_local ThreadLatenciesCache cache;
+    return cache;
+}
+
+
+// wraps a table (or TableAdapter for runtime polymorphism) and records latencies of operations
+// every thread records into its own histograms without locks, they are merged by getLatencies
+// with sampling period n only every n-th operation of a thread is measured (by readTimestamp):
+// an unmeasured operation costs a few loads and a branch, a measured one costs two timestamps
+// and isn't overlapped with neighbour operations, so sampling is needed for fast tables
+// clear, isEmpty and getSize are not measured
+template <class TableType>
+class InstrumentedTable :
+    public StaticTableInterface<InstrumentedTable<TableType>, typename TableType::elem_type> {
+
+    using ElemType = typename TableType::elem_type;
+
+    TableType table;
+    size_t samplingPeriod = 1;
+    double nsPerTimestamp = getNsPerTimestamp();
+    uint64_t id = getNextInstrumentedTableId();
+    mutable std::mutex mutex;  // guards the list of threads, not the histograms
+    std::vector<std::unique_ptr<ThreadLatencies>> threads;
+
+    // the last used table of the thread is cached, other tables are searched in the cache of the thread,
+    // the list of threads is locked only by the first operation of the thread with the table
+    ThreadLatencies& getThreadLatencies() {
+        thread_local uint64_t cachedId = 0;
+        thread_local ThreadLatencies* cachedLatencies = nullptr;
+        if (cachedId == id) return *cachedLatencies;
+
+        ThreadLatenciesCache& cache = getThreadLatenciesCache();
+        auto cached = cache.tables.find(id);
+        if (cached != cache.tables.end()) {
+            cachedId = id;
+            cachedLatencies = cached->second;
+            return *cachedLatencies;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        std::thread::id thread = std::this_thread::get_id();
+        auto it = std::find_if(threads.begin(), threads.end(),
+            [thread](const std::unique_ptr<ThreadLatencies>& latencies) { return latencies->thread == thread; });
+        if (it == threads.end()) {
+            threads.emplace_back(new ThreadLatencies());
+            threads.back()->thread = thread;
+            it = threads.end() - 1;
+        }
+        cache.add(id, it->get());
+        cachedId = id;
+        cachedLatencies = it->get();
+        return *cachedLatencies;
+    }
+
+    // the id is listed while the table exists, caches of threads drop the other ids
+    void registerId() {
+        std::lock_guard<std::mutex> lock(getInstrumentedTableIdsMutex());
+        getInstrumentedTableIds().insert(id);
+    }
+
+    template <class Function>
+    auto measure(TableOperation operation, Function function) -> decltype(function()) {
+        ThreadLatencies& latencies = getThreadLatencies();
+        if (latencies.skipped > 0) {
+            latencies.skipped--;
+            return function();
+        }
+        latencies.skipped = samplingPeriod - 1;
+
+        uint64_t start = readTimestamp();
+        auto res = function();
+        uint64_t time = readTimestamp() - start;
+        latencies.histograms[size_t(operation)].record(uint64_t(double(time) * nsPerTimestamp));
+        return res;
+    }
+
+public:
+
+    InstrumentedTable() {
+        registerId();
+    }
+
+    // arguments are passed to the constructor of the table, an instrumented table as the first one is not,
+    // instrumented tables are not copyable
+    template <class FirstArg, class... Args,
+        class = typename std::enable_if<!std::is_same<typename std::decay<FirstArg>::type, InstrumentedTable>::value>::type>
+    explicit InstrumentedTable(FirstArg&& firstArg, Args&&... args) :
+        table(std::forward<FirstArg>(firstArg), std::forward<Args>(args)...) {
+        registerId();
+    }
+
+    ~InstrumentedTable() {
+        std::lock_guard<std::mutex> lock(getInstrumentedTableIdsMutex());
+        getInstrumentedTableIds().erase(id);
+    }
+
+    TableType& getTable() {
+        return table;
+    }
+
+    // 1 means that every operation is measured
+    void setSamplingPeriod(size_t period) {
+        if (period == 0) throw "Sampling period must be positive";
+        samplingPeriod = period;
+    }
+
+    bool insert(const KeyType& key, const ElemType& elem) {
+        return measure(TableOperation::INSERT, [&]() { return table.insert(key, elem); });
+    }
+
+    bool erase(const KeyType& key) {
+        return measure(TableOperation::ERASE, [&]() { return table.erase(key); });
+    }
+
+    std::pair<KeyType, ElemType>* find(const KeyType& key) {
+        return measure(TableOperation::FIND, [&]() { return table.find(key); });
+    }
+
+    std::pair<std::pair<KeyType, ElemType>*, bool> findOrInsert(const KeyType& key, const ElemType& elem) {
+        return measure(TableOperation::FIND_OR_INSERT, [&]() { return table.findOrInsert(key, elem); });
+    }
+
+    void clear() {
+        table.clear();
+    }
+
+    bool isEmpty() const {
+        return table.isEmpty();
+    }
+
+    size_t getSize() const {
+        return table.getSize();
+    }
+
+    // histograms of threads are metadata
+    MemoryUsage getMemoryUsage() const {
+        MemoryUsage res = table.getMemoryUsage();
+        std::lock_guard<std::mutex> lock(mutex);
+        res.nodeBytes += threads.size() * sizeof(ThreadLatencies);
+        res.metadataBytes += threads.size() * sizeof(ThreadLatencies);
+        return res;
+    }
+
+    // latencies of all threads, ns
+    LatencyHistogram getLatencies(TableOperation operation) const {
+        LatencyHistogram res;
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const std::unique_ptr<ThreadLatencies>& latencies : threads)
+            res.merge(latencies->histograms[size_t(operation)]);
+        return res;
+    }
+
+    // must not be called while operations are running
+    void resetLatencies() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const std::unique_ptr<ThreadLatencies>& latencies : threads)
+            for (LatencyHistogram& histogram : latencies->histograms)
+                histogram.reset();
+    }
+
+    // histograms of operations which were called
+    void dumpLatencies(std::ostream& ostr) const {
+        for (size_t i = 0; i < size_t(TableOperation::COUNT); i++) {
+            LatencyHistogram histogram = getLatencies(TableOperation(i));
+            if (histogram.getCount())
+                ostr << getName(TableOperation(i)) << " latencies, ns: " << histogram;
+        }
+    }
+
+};
@@ -1,5 +1,16 @@
 ﻿#pragma once
+#include "PoolAllocator.h"
+
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+// lists shorter than this are sorted by one thread in parallelSort
+const size_t MIN_PARALLEL_SORT_SIZE_LIST = size_t(1) << 14;
 
 
 template <class T>
@@ -12,24 +23,191 @@ struct Node {
 };
 
 
-template <class T>
+// forward iterator over nodes, Value is T or const T
+template <class T, class Value = T>
+class ListIterator {
+    Node<T>* node;
+
+public:
+
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Value* pointer;
+    typedef Value& reference;
+
+    ListIterator(Node<T>* node = nullptr) : node(node) {}
+
+    operator ListIterator<T, const T>() const {
+        return ListIterator<T, const T>(node);
+    }
+
+    Node<T>* getNode() const {
+        return node;
+    }
+
+    Value& operator*() const {
+        return node->data;
+    }
+
+    Value* operator->() const {
+        return &(node->data);
+    }
+
+    ListIterator& operator++() {
+        node = node->next;
+        return *this;
+    }
+
+    ListIterator operator++(int) {
+        ListIterator tmp = *this;
+        node = node->next;
+        return tmp;
+    }
+
+    friend bool operator==(const ListIterator& it1, const ListIterator& it2) {
+        return it1.node == it2.node;
+    }
+
+    friend bool operator!=(const ListIterator& it1, const ListIterator& it2) {
+        return it1.node != it2.node;
+    }
+};
+
+
+// nodes are allocated by Allocator rebound to Node<T>
+// default PoolAllocator takes nodes from slabs and reuses freed ones,
+// copies of a list share the pool of the original list
+// the list keeps pointer to the last node and the number of nodes,
+// so pushBack and getSize are O(1), popBack is O(n) (see DoublyLinkedList)
+template <class T, class Allocator = PoolAllocator<T>>
 class List {
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node<T>>;
+    using NodeAllocatorTraits = std::allocator_traits<NodeAllocator>;
+
     Node<T>* first = nullptr;
+    Node<T>* last = nullptr;
+    size_t size = 0;
+    NodeAllocator allocator;
+
+    Node<T>* createNode(const T& data, Node<T>* next) {
+        Node<T>* node = NodeAllocatorTraits::allocate(allocator, 1);
+        try {
+            NodeAllocatorTraits::construct(allocator, node, data, next);
+        }
+        catch (...) {
+            NodeAllocatorTraits::deallocate(allocator, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    void destroyNode(Node<T>* node) {
+        NodeAllocatorTraits::destroy(allocator, node);
+        NodeAllocatorTraits::deallocate(allocator, node, 1);
+    }
 
     void copyToEmptyList(const List& list) {
-        Node<T>* current = nullptr;
         for (Node<T>* ptr = list.first; ptr; ptr = ptr->next)
-            current = insertAfter(ptr->data, current);
+            pushBack(ptr->data);
+    }
+
+    // takes nodes of the list, which must be empty, the other list becomes empty
+    void stealNodes(List& list) {
+        first = list.first;
+        last = list.last;
+        size = list.size;
+        list.first = list.last = nullptr;
+        list.size = 0;
+    }
+
+    void checkAllocatorsForSplice(const List& list) const {
+        if (allocator != list.allocator)
+            throw "Lists with different allocators can't be spliced";
+    }
+
+    // cuts the chain after count nodes, returns the rest of the chain
+    static Node<T>* cutAfter(Node<T>* node, size_t count) {
+        if (!node) return nullptr;
+        for (size_t i = 1; i < count && node->next; i++)
+            node = node->next;
+        Node<T>* rest = node->next;
+        node->next = nullptr;
+        return rest;
+    }
+
+    // nodes linked one by one, last->next is nullptr
+    struct Chain {
+        Node<T>* first = nullptr;
+        Node<T>* last = nullptr;
+    };
+
+    // merges two sorted chains by relinking nodes, equal elements of chain1 go first, O(n + m)
+    template <class Compare>
+    static Chain mergeChains(Chain chain1, Chain chain2, Compare& compare) {
+        if (!chain1.first) return chain2;
+        if (!chain2.first) return chain1;
+        Chain result;
+        Node<T>** link = &result.first;
+        Node<T> *ptr1 = chain1.first, *ptr2 = chain2.first;
+        while (ptr1 && ptr2) {
+            Node<T>*& taken = compare(ptr2->data, ptr1->data) ? ptr2 : ptr1;
+            *link = taken;
+            link = &(taken->next);
+            taken = taken->next;
+        }
+        *link = ptr1 ? ptr1 : ptr2;
+        result.last = ptr1 ? chain1.last : chain2.last;
+        return result;
+    }
+
+    // bottom-up merge sort, stable, O(n log n) without allocations
+    // nodes are taken one by one and sorted runs of equal length are merged at once,
+    // so recently touched nodes are merged again while they are in cache
+    template <class Compare>
+    static Chain sortChain(Node<T>* head, Compare& compare) {
+        Chain bins[64];  // bins[i] is empty or contains 2^i nodes, earlier nodes are in higher bins
+        size_t binsCount = 0;
+        while (head) {
+            Chain carry;
+            carry.first = carry.last = head;
+            head = head->next;
+            carry.last->next = nullptr;
+            size_t i = 0;
+            for (; bins[i].first; i++) {
+                carry = mergeChains(bins[i], carry, compare);
+                bins[i] = Chain();
+            }
+            bins[i] = carry;
+            if (i == binsCount) binsCount++;
+        }
+        Chain result;
+        for (size_t i = 0; i < binsCount; i++)
+            result = mergeChains(bins[i], result, compare);
+        return result;
     }
 
 public:
 
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef ListIterator<T> iterator;
+    typedef ListIterator<T, const T> const_iterator;
+
     List() {}
 
-    List(const List& list) {
+    explicit List(const Allocator& allocator) : allocator(allocator) {}
+
+    List(const List& list) :
+        allocator(NodeAllocatorTraits::select_on_container_copy_construction(list.allocator)) {
         copyToEmptyList(list);
     }
 
+    // nodes are taken without copying, the allocator is moved together with them
+    List(List&& list) noexcept : allocator(std::move(list.allocator)) {
+        stealNodes(list);
+    }
+
     ~List() {
         clear();
     }
@@ -38,7 +216,41 @@ public:
         return first;
     }
 
-    List<T>& operator=(const List<T>& list) {
+    Node<T>* getLast() const {
+        return last;
+    }
+
+    size_t getSize() const {
+        return size;
+    }
+
+    // number of elements which fit into the allocated memory
+    size_t getCapacity() const {
+        return size;
+    }
+
+    // memory allocated for nodes, bytes
+    size_t getAllocatedBytes() const {
+        return size * sizeof(Node<T>);
+    }
+
+    iterator begin() {
+        return iterator(first);
+    }
+
+    iterator end() {
+        return iterator();
+    }
+
+    const_iterator begin() const {
+        return const_iterator(first);
+    }
+
+    const_iterator end() const {
+        return const_iterator();
+    }
+
+    List& operator=(const List& list) {
         if (&list != this) {
             clear();
             copyToEmptyList(list);
@@ -46,7 +258,23 @@ public:
         return *this;
     }
 
-    friend bool operator==(const List<T>& list1, const List<T>& list2) {
+    // nodes are taken if allocators are equal, otherwise elements are copied
+    List& operator=(List&& list) {
+        if (&list != this) {
+            clear();
+            if (allocator == list.allocator) {
+                stealNodes(list);
+            }
+            else {
+                copyToEmptyList(list);
+                list.clear();
+            }
+        }
+        return *this;
+    }
+
+    friend bool operator==(const List& list1, const List& list2) {
+        if (list1.size != list2.size) return false;
         Node<T> *ptr1 = list1.first, *ptr2 = list2.first;
         while (ptr1 && ptr2) {
             if (ptr1->data != ptr2->data) return false;
@@ -56,30 +284,31 @@ public:
         return true;
     }
 
-    friend bool operator!=(const List<T>& list1, const List<T>& list2) {
+    friend bool operator!=(const List& list1, const List& list2) {
         return !(list1 == list2);
     }
 
     Node<T>* pushFront(const T& data) {  // returns new node
-        first = new Node<T>(data, first);
+        first = createNode(data, first);
+        if (!last) last = first;
+        size++;
         return first;
     }
 
     void popFront() {
         if (empty()) return;
         Node<T>* newFirst = first->next;
-        delete first;
+        destroyNode(first);
         first = newFirst;
+        if (!first) last = nullptr;
+        size--;
     }
 
-    Node<T>* pushBack(const T& data) {  // returns new node
-        if (empty()) return pushFront(data);
-        Node<T>* current = first;
-        while (current->next) current = current->next;
-        return insertAfter(data, current);
+    Node<T>* pushBack(const T& data) {  // returns new node, O(1)
+        return insertAfter(data, last);
     }
 
-    void popBack() {
+    void popBack() {  // O(n)
         if (empty()) return;
         if (!first->next) {
             popFront();
@@ -92,7 +321,9 @@ public:
 
     Node<T>* insertAfter(const T& data, Node<T>* prevNode = nullptr) {  // returns new node
         if (!prevNode) return pushFront(data);
-        prevNode->next = new Node<T>(data, prevNode->next);
+        prevNode->next = createNode(data, prevNode->next);
+        if (last == prevNode) last = prevNode->next;
+        size++;
         return prevNode->next;
     }
 
@@ -103,19 +334,154 @@ public:
         }
         if (!prevNode->next) return;
         Node<T>* tmp = prevNode->next->next;
-        delete prevNode->next;
+        destroyNode(prevNode->next);
         prevNode->next = tmp;
+        if (!tmp) last = prevNode;
+        size--;
+    }
+
+    // moves all nodes of the list after prevNode (to the beginning if prevNode is nullptr), O(1)
+    // lists must have equal allocators
+    void spliceAfter(Node<T>* prevNode, List& list) {
+        if (&list == this || list.empty()) return;
+        spliceAfter(prevNode, list, nullptr, list.last, list.size);
     }
 
-    bool empty() {
+    // moves nodes (beforeFirst, lastNode] of the list after prevNode, O(1)
+    // beforeFirst == nullptr means the range starts from the first node of the list,
+    // count is the number of moved nodes, prevNode must not be in the range
+    // lists must have equal allocators
+    void spliceAfter(Node<T>* prevNode, List& list, Node<T>* beforeFirst, Node<T>* lastNode, size_t count) {
+        checkAllocatorsForSplice(list);
+        Node<T>*& rangeFirst = beforeFirst ? beforeFirst->next : list.first;
+        if (rangeFirst == nullptr || lastNode == beforeFirst) return;
+        Node<T>* firstNode = rangeFirst;
+
+        // unlink the range from the list
+        rangeFirst = lastNode->next;
+        if (list.last == lastNode) list.last = beforeFirst;
+        list.size -= count;
+
+        // link the range after prevNode
+        Node<T>*& next = prevNode ? prevNode->next : first;
+        lastNode->next = next;
+        next = firstNode;
+        if (last == prevNode) last = lastNode;
+        size += count;
+    }
+
+    // stable merge sort, nodes are relinked, so pointers to them stay valid
+    // O(n log n), no memory is allocated
+    template <class Compare = std::less<T>>
+    void sort(Compare compare = Compare()) {
+        Chain sorted = sortChain(first, compare);
+        first = sorted.first;
+        last = sorted.last;
+    }
+
+    // merges the sorted list into this sorted list, O(n + m)
+    // nodes are relinked, the list becomes empty, lists must have equal allocators
+    // equal elements of this list go first
+    template <class Compare = std::less<T>>
+    void merge(List& list, Compare compare = Compare()) {
+        if (&list == this) return;
+        checkAllocatorsForSplice(list);
+        Chain chain1, chain2;
+        chain1.first = first;
+        chain1.last = last;
+        chain2.first = list.first;
+        chain2.last = list.last;
+        Chain merged = mergeChains(chain1, chain2, compare);
+        first = merged.first;
+        last = merged.last;
+        size += list.size;
+        list.first = list.last = nullptr;
+        list.size = 0;
+    }
+
+    // the list is cut into parts sorted by separate threads, then parts are merged pairwise
+    // the result is the same as of sort(), compare is copied to every thread
+    template <class Compare = std::less<T>>
+    void parallelSort(size_t threadsCount = std::thread::hardware_concurrency(), Compare compare = Compare()) {
+        if (threadsCount < 2 || size < MIN_PARALLEL_SORT_SIZE_LIST) {
+            sort(compare);
+            return;
+        }
+
+        // parts keep the order of the list, so merging neighbours is stable
+        const size_t partSize = (size + threadsCount - 1) / threadsCount;
+        std::vector<Chain> parts;
+        for (Node<T>* rest = first; rest; ) {
+            parts.push_back(Chain());
+            parts.back().first = rest;
+            rest = cutAfter(rest, partSize);
+        }
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < parts.size(); i++)
+            threads.emplace_back([&parts, i, compare]() mutable {
+                parts[i] = sortChain(parts[i].first, compare);
+            });
+        for (std::thread& thread : threads)
+            thread.join();
+
+        for (size_t step = 1; step < parts.size(); step *= 2) {
+            threads.clear();
+            for (size_t i = 0; i + step < parts.size(); i += 2 * step)
+                threads.emplace_back([&parts, i, step, compare]() mutable {
+                    parts[i] = mergeChains(parts[i], parts[i + step], compare);
+                });
+            for (std::thread& thread : threads)
+                thread.join();
+        }
+        first = parts[0].first;
+        last = parts[0].last;
+    }
+
+    // moves every node to the front of list getList(data), nodes are relinked, O(n)
+    // lists must have equal allocators, this list becomes empty
+    template <class GetList>
+    void moveAllTo(GetList getList) {
+        while (first)
+            getList(first->data).spliceAfter(nullptr, *this, nullptr, first, 1);
+    }
+
+    // returns pointer to data of the first node satisfying predicate or nullptr
+    template <class Predicate>
+    T* findFirst(Predicate predicate) {
+        for (Node<T>* ptr = first; ptr; ptr = ptr->next)
+            if (predicate(ptr->data)) return &(ptr->data);
+        return nullptr;
+    }
+
+    // erases the first node satisfying predicate in one pass
+    // returns true if node was erased
+    template <class Predicate>
+    bool eraseFirst(Predicate predicate) {
+        Node<T>* prevPtr = nullptr;
+        for (Node<T>* ptr = first; ptr; prevPtr = ptr, ptr = ptr->next)
+            if (predicate(ptr->data)) {
+                eraseAfter(prevPtr);
+                return true;
+            }
+        return false;
+    }
+
+    bool empty() const {
         return first == nullptr;
     }
 
     void clear() {
         while (first) popFront();
+        last = nullptr;
+        releaseUnusedMemory(allocator);  // whole slabs are freed if the pool is not shared
+    }
+
+    allocator_type getAllocator() const {
+        return allocator_type(allocator);
     }
 
-    friend std::ostream& operator<<(std::ostream& ostr, const List<T>& list) {
+    friend std::ostream& operator<<(std::ostream& ostr, const List& list) {
         for (Node<T>* ptr = list.getFirst(); ptr; ptr = ptr->next)
             ostr << ptr->data << "; ";
         ostr << std::endl;
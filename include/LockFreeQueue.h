@@ -0,0 +1,99 @@
+#pragma once
+#include "HazardPointers.h"
+
+#include <atomic>
+
+
+template <class T>
+struct LockFreeQueueNode {
+    T data;
+    std::atomic<LockFreeQueueNode*> next{ nullptr };
+
+    LockFreeQueueNode() {}
+    LockFreeQueueNode(const T& data) : data(data) {}
+};
+
+
+// lock-free FIFO container (M. Michael, M. Scott, 1996)
+// head is a dummy node, elements are stored in the nodes after it
+// nodes have atomic links, because push changes next of the last node concurrently with pop
+// removed nodes are deleted via hazard pointers, because other threads may still read them
+template <class T>
+class LockFreeQueue {
+    using Node = LockFreeQueueNode<T>;
+
+    std::atomic<Node*> head;
+    std::atomic<Node*> tail;
+
+public:
+
+    LockFreeQueue() {
+        Node* dummy = new Node();
+        head.store(dummy);
+        tail.store(dummy);
+    }
+
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+    // must not be called while other threads use the queue
+    ~LockFreeQueue() {
+        for (Node* node = head.load(); node; ) {
+            Node* next = node->next.load();
+            delete node;
+            node = next;
+        }
+    }
+
+    void push(const T& data) {
+        Node* node = new Node(data);
+        while (true) {
+            Node* last = HazardPointers::protect(0, tail);
+            Node* next = last->next.load();
+            if (last != tail.load()) continue;
+            if (next) {  // tail is behind, help to move it
+                tail.compare_exchange_weak(last, next);
+                continue;
+            }
+            if (last->next.compare_exchange_weak(next, node)) {
+                tail.compare_exchange_strong(last, node);
+                break;
+            }
+        }
+        HazardPointers::clear(0);
+    }
+
+    // returns false if the queue is empty
+    bool pop(T& data) {
+        while (true) {
+            Node* first = HazardPointers::protect(0, head);
+            Node* last = tail.load();
+            Node* next = first->next.load();
+            HazardPointers::set(1, next);
+            if (first != head.load()) continue;  // next may be already deleted
+            if (!next) {
+                HazardPointers::clear(0);
+                return false;
+            }
+            if (first == last) {  // tail is behind, help to move it
+                tail.compare_exchange_weak(last, next);
+                continue;
+            }
+            if (head.compare_exchange_strong(first, next)) {
+                // next becomes the dummy node, its data is not read by other threads
+                data = std::move(next->data);
+                HazardPointers::clear(0);
+                HazardPointers::clear(1);
+                HazardPointers::retire(first);
+                return true;
+            }
+        }
+    }
+
+    // the result may be outdated if other threads use the queue
+    bool empty() const {
+        bool result = HazardPointers::protect(0, head)->next.load() == nullptr;
+        HazardPointers::clear(0);
+        return result;
+    }
+};
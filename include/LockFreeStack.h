@@ -0,0 +1,82 @@
+#pragma once
+#include "List.h"
+#include "HazardPointers.h"
+
+#include <atomic>
+#include <cstdint>
+
+
+// lock-free LIFO container (Treiber stack) on nodes of List
+// the head pointer is packed together with a counter of changes,
+// so compare-and-swap fails if the head was popped and pushed again (ABA problem)
+// popped nodes are deleted via hazard pointers, because other threads may still read them
+template <class T>
+class LockFreeStack {
+
+    // user space addresses fit in 48 bits on 64-bit platforms, the other bits are the counter
+    static const unsigned TAG_SHIFT = sizeof(void*) == 8 ? 48 : 32;
+
+    std::atomic<uint64_t> head{ 0 };
+
+    static uint64_t pack(Node<T>* node, uint64_t tag) {
+        return uint64_t(uintptr_t(node)) | (tag << TAG_SHIFT);
+    }
+
+    static Node<T>* getNode(uint64_t tagged) {
+        return reinterpret_cast<Node<T>*>(uintptr_t(tagged & ((uint64_t(1) << TAG_SHIFT) - 1)));
+    }
+
+    static uint64_t getTag(uint64_t tagged) {
+        return tagged >> TAG_SHIFT;
+    }
+
+public:
+
+    LockFreeStack() {}
+    LockFreeStack(const LockFreeStack&) = delete;
+    LockFreeStack& operator=(const LockFreeStack&) = delete;
+
+    // must not be called while other threads use the stack
+    ~LockFreeStack() {
+        for (Node<T>* node = getNode(head.load()); node; ) {
+            Node<T>* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    void push(const T& data) {
+        Node<T>* node = new Node<T>(data);
+        uint64_t oldHead = head.load();
+        do {
+            node->next = getNode(oldHead);
+        } while (!head.compare_exchange_weak(oldHead, pack(node, getTag(oldHead) + 1)));
+    }
+
+    // returns false if the stack is empty
+    bool pop(T& data) {
+        while (true) {
+            uint64_t oldHead = head.load();
+            Node<T>* node = getNode(oldHead);
+            if (!node) {
+                HazardPointers::clear(0);  // a node of a retry isn't protected, so it can be reclaimed
+                return false;
+            }
+            HazardPointers::set(0, node);
+            if (head.load() != oldHead) continue;  // node may be already deleted
+
+            // next is not changed while the node is in the stack
+            if (head.compare_exchange_strong(oldHead, pack(node->next, getTag(oldHead) + 1))) {
+                HazardPointers::clear(0);
+                data = std::move(node->data);
+                HazardPointers::retire(node);
+                return true;
+            }
+        }
+    }
+
+    // the result may be outdated if other threads use the stack
+    bool empty() const {
+        return getNode(head.load()) == nullptr;
+    }
+};
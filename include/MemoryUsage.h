@@ -0,0 +1,143 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+
+// memory of a table, bytes, it is returned by getMemoryUsage() of tables
+// arrayBytes + nodeBytes is the memory of the table itself, it is split into
+// elementBytes + metadataBytes + slackBytes
+// free blocks kept by pool allocators are not counted
+struct MemoryUsage {
+    size_t arrayBytes = 0;     // arrays of cells, buckets, keys and bitmaps (by capacity)
+    size_t nodeBytes = 0;      // separately allocated nodes of lists and trees, chunks, overflow arrays
+
+    size_t elementBytes = 0;   // pairs (key, element)
+    size_t metadataBytes = 0;  // flags, cached hashes, pointers, padding, headers of buckets, inner nodes
+    size_t slackBytes = 0;     // unused capacity: empty and deleted cells, free slots of chunks and nodes
+
+    // heap memory owned by elements, see getHeapBytes, it includes erased elements which are kept
+    // by the table till their cells are reused (deleted cells of open addressing, cells after the size of arrays)
+    size_t elementHeapBytes = 0;
+
+    size_t getTotal() const {
+        return arrayBytes + nodeBytes + elementHeapBytes;
+    }
+
+    // array of capacity cells of cellSize bytes, used cells contain elements of elementSize bytes
+    void addArray(size_t capacity, size_t used, size_t cellSize, size_t elementSize) {
+        arrayBytes += capacity * cellSize;
+        elementBytes += used * elementSize;
+        metadataBytes += used * (cellSize - elementSize);
+        slackBytes += (capacity - used) * cellSize;
+    }
+
+    friend std::ostream& operator<<(std::ostream& ostr, const MemoryUsage& usage) {
+        ostr << "total: " << usage.getTotal() << " bytes (arrays: " << usage.arrayBytes
+            << ", nodes: " << usage.nodeBytes << ", element heap: " << usage.elementHeapBytes
+            << "), elements: " << usage.elementBytes << ", metadata: " << usage.metadataBytes
+            << ", slack: " << usage.slackBytes << std::endl;
+        return ostr;
+    }
+};
+
+
+// heap memory owned by an element, it is 0 for types without overloads
+// overloads for other types can be declared next to them (they are found by argument-dependent lookup)
+template <class T>
+size_t getHeapBytes(const T&) {
+    return 0;
+}
+
+template <class Char, class Traits, class Allocator>
+size_t getHeapBytes(const std::basic_string<Char, Traits, Allocator>& str) {
+    const char* data = reinterpret_cast<const char*>(str.data());
+    const char* object = reinterpret_cast<const char*>(&str);
+    std::less<const char*> less;
+    if (!less(data, object) && less(data, object + sizeof(str)))
+        return 0;  // short string is kept inside of the object
+    return (str.capacity() + 1) * sizeof(Char);
+}
+
+template <class T, class Allocator>
+size_t getHeapBytes(const std::vector<T, Allocator>& vector) {
+    size_t res = vector.capacity() * sizeof(T);
+    for (const T& elem : vector)
+        res += getHeapBytes(elem);
+    return res;
+}
+
+
+// allocations made through CountingAllocator
+// counters are not atomic, so a counter must be used by one thread
+struct AllocationCounter {
+    size_t bytes = 0;         // allocated and not freed
+    size_t peakBytes = 0;
+    size_t allocations = 0;
+    size_t deallocations = 0;
+};
+
+// counter of default constructed allocators
+inline AllocationCounter& getDefaultAllocationCounter() {
+    static AllocationCounter counter;
+    return counter;
+}
+
+// allocator that counts memory taken from operator new,
+// elements with containers on this allocator report their heap memory exactly,
+// and a counter which is not zero after destruction of a table shows a leak
+// copies (including rebound ones) use the same counter, allocators are equal if counters are equal
+// the allocator is propagated on assignment, so assigned elements are counted by the counter of the source
+template <class T>
+class CountingAllocator {
+    AllocationCounter* counter;
+
+    template <class U> friend class CountingAllocator;
+
+public:
+
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    CountingAllocator() : counter(&getDefaultAllocationCounter()) {}
+
+    explicit CountingAllocator(AllocationCounter& counter) : counter(&counter) {}
+
+    template <class U>
+    CountingAllocator(const CountingAllocator<U>& allocator) : counter(allocator.counter) {}
+
+    AllocationCounter& getCounter() const {
+        return *counter;
+    }
+
+    T* allocate(size_t n) {
+        T* ptr = static_cast<T*>(::operator new(n * sizeof(T)));
+        counter->bytes += n * sizeof(T);
+        counter->peakBytes = std::max(counter->peakBytes, counter->bytes);
+        counter->allocations++;
+        return ptr;
+    }
+
+    void deallocate(T* ptr, size_t n) {
+        counter->bytes -= n * sizeof(T);
+        counter->deallocations++;
+        ::operator delete(ptr);
+    }
+
+    template <class U>
+    friend bool operator==(const CountingAllocator& allocator1, const CountingAllocator<U>& allocator2) {
+        return &allocator1.getCounter() == &allocator2.getCounter();
+    }
+
+    template <class U>
+    friend bool operator!=(const CountingAllocator& allocator1, const CountingAllocator<U>& allocator2) {
+        return &allocator1.getCounter() != &allocator2.getCounter();
+    }
+};
@@ -0,0 +1,111 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+
+const size_t START_BLOCK_SIZE_MONOTONIC_ARENA = 4096;  // bytes, blocks grow twice
+
+
+// arena for objects with the same lifetime (e.g. tables of one request)
+// memory is taken from blocks by moving a pointer, deallocation does nothing,
+// all blocks are freed at once by release() or by the destructor
+// the arena is not thread-safe
+class MonotonicArena {
+    std::vector<char*> blocks;
+    size_t nextBlockSize = START_BLOCK_SIZE_MONOTONIC_ARENA;
+    char* current = nullptr;  // free part of the last block is [current, end)
+    char* end = nullptr;
+    size_t allocatedBytes = 0;
+    size_t usedBytes = 0;
+
+    void addBlock(size_t minSize) {
+        while (nextBlockSize < minSize) nextBlockSize *= 2;
+        char* block = static_cast<char*>(::operator new(nextBlockSize));
+        blocks.push_back(block);
+        current = block;
+        end = block + nextBlockSize;
+        allocatedBytes += nextBlockSize;
+        nextBlockSize *= 2;
+    }
+
+public:
+
+    MonotonicArena() {}
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ~MonotonicArena() {
+        release();
+    }
+
+    void* allocate(size_t size, size_t alignment) {
+        size_t padding = (alignment - uintptr_t(current) % alignment) % alignment;
+        if (!current || size_t(end - current) < size + padding) {
+            addBlock(size + alignment);
+            padding = (alignment - uintptr_t(current) % alignment) % alignment;
+        }
+        void* ptr = current + padding;
+        current += padding + size;
+        usedBytes += size;
+        return ptr;
+    }
+
+    // objects must not be used after that
+    void release() {
+        for (char* block : blocks)
+            ::operator delete(block);
+        blocks.clear();
+        current = end = nullptr;
+        nextBlockSize = START_BLOCK_SIZE_MONOTONIC_ARENA;
+        allocatedBytes = usedBytes = 0;
+    }
+
+    // memory of blocks
+    size_t getAllocatedBytes() const {
+        return allocatedBytes;
+    }
+
+    // memory given to objects, freed memory is counted too
+    size_t getUsedBytes() const {
+        return usedBytes;
+    }
+};
+
+
+// allocator from MonotonicArena, it has no default constructor because the arena must be given
+// copies (including rebound ones) use the same arena, allocators are equal if arenas are equal
+template <class T>
+class ArenaAllocator {
+    MonotonicArena* arena;
+
+public:
+
+    typedef T value_type;
+
+    explicit ArenaAllocator(MonotonicArena& arena) : arena(&arena) {}
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& allocator) : arena(&allocator.getArena()) {}
+
+    MonotonicArena& getArena() const {
+        return *arena;
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) {}
+
+    template <class U>
+    friend bool operator==(const ArenaAllocator& allocator1, const ArenaAllocator<U>& allocator2) {
+        return &allocator1.getArena() == &allocator2.getArena();
+    }
+
+    template <class U>
+    friend bool operator!=(const ArenaAllocator& allocator1, const ArenaAllocator<U>& allocator2) {
+        return &allocator1.getArena() != &allocator2.getArena();
+    }
+};
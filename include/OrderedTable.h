@@ -2,8 +2,11 @@
 #include "Table.h"
 
 
-template <class ElemType>
-class OrderedTable : public TableByArray<ElemType> {
+template <class ElemType, class Allocator = std::allocator<std::pair<KeyType, ElemType>>>
+class OrderedTable : public TableByArray<ElemType, std::pair<KeyType, ElemType>, Allocator>,
+    public StaticTableInterface<OrderedTable<ElemType, Allocator>, ElemType> {
+
+    using BaseClass = TableByArray<ElemType, std::pair<KeyType, ElemType>, Allocator>;
 
     // temporary O(n)
     // returns position to insert
@@ -21,8 +24,14 @@ class OrderedTable : public TableByArray<ElemType> {
 
 public:
 
+    OrderedTable(size_t storageSize = START_STORAGE_SIZE, const Allocator& allocator = Allocator()) :
+        BaseClass(storageSize, allocator) {}
+
+    OrderedTable(const GrowthPolicy& growthPolicy, const Allocator& allocator = Allocator()) :
+        BaseClass(growthPolicy, allocator) {}
+
     // binary search O(log(n))
-    std::pair<KeyType, ElemType>* find(const KeyType& key) override {
+    std::pair<KeyType, ElemType>* find(const KeyType& key) {
         size_t searchRes = binarySearch(key);
         if (searchRes == size || storage[searchRes].first != key) // key does not exist
             return nullptr;
@@ -30,10 +39,15 @@ public:
     }
 
     // insertion O(log(n)) + O(n)
-    bool insert(const KeyType& key, const ElemType& elem) override {
+    bool insert(const KeyType& key, const ElemType& elem) {
+        return findOrInsert(key, elem).second;
+    }
+
+    // binary search O(log(n)) and insertion O(n) if key does not exist
+    std::pair<std::pair<KeyType, ElemType>*, bool> findOrInsert(const KeyType& key, const ElemType& elem) {
         size_t searchRes = binarySearch(key);
         if (searchRes != size && storage[searchRes].first == key)  // key already exists
-            return false;
+            return std::make_pair(&(storage[searchRes]), false);
 
         if (storage.size() == size) repack();
         
@@ -42,11 +56,11 @@ public:
         storage[searchRes] = std::make_pair(key, elem);
         size++;
 
-        return true;
+        return std::make_pair(&(storage[searchRes]), true);
     }
 
     // erasing O(log(n)) + O(n)
-    bool erase(const KeyType& key) override {
+    bool erase(const KeyType& key) {
         size_t searchRes = binarySearch(key);
         if (searchRes == size || storage[searchRes].first != key)  // key does not exist
             return false;
@@ -58,4 +72,8 @@ public:
         return true;
     }
 
+    MemoryUsage getMemoryUsage() const {
+        return BaseClass::getPackedMemoryUsage();
+    }
+
 };
@@ -0,0 +1,268 @@
+#pragma once
+#include "Table.h"
+#include "Intrinsics.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+const double GAMMA_PERFECT_HASH_TABLE = 1.5;
+const size_t MAX_LEVELS_PERFECT_HASH_TABLE = 32;
+const size_t RANK_BLOCK_WORDS_PERFECT_HASH_TABLE = 8;  // one rank per 512 bits
+const uint32_t MAGIC_PERFECT_HASH_TABLE = 0x31485050;  // "PPH1"
+const size_t READ_CHUNK_BYTES_PERFECT_HASH_TABLE = size_t(1) << 20;  // saved vectors are read by chunks
+
+
+// read-only table for a static set of keys, it is built once from all elements
+// minimal perfect hash function (BBHash) maps n keys to 0..n-1 without collisions
+// and the element with the key is elements[index], the key is kept with the element
+// to answer searches of absent keys
+// the hash function is a sequence of bit arrays (levels): a key sets its bit in the first level
+// if no other key has the same bit, keys with collisions go to the next level, the index of a key
+// is the number of set bits before its bit (rank), keys left after all levels are kept in a sorted array
+// gamma is the size of a level per key, bits per key of the function are about
+// gamma * e^(1/gamma) + 1/16 (3.0 for gamma = 1.5), larger gamma makes searches check fewer levels
+// searches are O(1) on the average, but a search reads a bit of each checked level and the element:
+// for gamma = 1.5 half of keys are in the first level, so searches are slower than in open addressing
+// and the table is for memory (about 8.5 bytes per int element against 20-30 bytes of open addressing)
+template <class ElemType>
+class PerfectHashTable {
+
+    std::vector<uint64_t> bits;       // levels one after another
+    std::vector<uint32_t> ranks;      // number of set bits before each block of RANK_BLOCK_WORDS words
+    std::vector<uint64_t> levelOffsets;  // first bit of each level
+    std::vector<uint64_t> levelSizes;    // bits of each level, multiples of 64
+    std::vector<KeyType> fallbackKeys;   // keys left after all levels, sorted, their indices follow levels
+    size_t levelKeys = 0;                // number of keys placed in levels
+    std::vector<std::pair<KeyType, ElemType>> elements;
+
+    // hash of the key for the level (splitmix64 finalizer), levels use independent hashes
+    static uint64_t hash(KeyType key, size_t level) {
+        uint64_t x = (uint64_t(key) << 32 | level) + 0x9e3779b97f4a7c15ull;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+    // position in [0, levelSize) without division
+    static uint64_t reduce(uint64_t hashValue, uint64_t levelSize) {
+        return (uint64_t(uint32_t(hashValue)) * levelSize) >> 32;
+    }
+
+    static bool getBit(const std::vector<uint64_t>& words, uint64_t bit) {
+        return (words[bit >> 6] >> (bit & 63)) & 1;
+    }
+
+    static void setBit(std::vector<uint64_t>& words, uint64_t bit) {
+        words[bit >> 6] |= uint64_t(1) << (bit & 63);
+    }
+
+    // number of set bits before the bit
+    size_t getRank(uint64_t bit) const {
+        size_t word = size_t(bit >> 6);
+        size_t block = word / RANK_BLOCK_WORDS_PERFECT_HASH_TABLE;
+        size_t res = ranks[block];
+        for (size_t i = block * RANK_BLOCK_WORDS_PERFECT_HASH_TABLE; i < word; i++)
+            res += popCount(bits[i]);
+        return res + popCount(bits[word] & ((uint64_t(1) << (bit & 63)) - 1));
+    }
+
+    void computeRanks() {
+        if (bits.size() >= (uint64_t(1) << 26)) throw "Too many keys for perfect hash table";
+        ranks.assign(bits.size() / RANK_BLOCK_WORDS_PERFECT_HASH_TABLE + 1, 0);
+        uint32_t count = 0;
+        for (size_t i = 0; i < bits.size(); i++) {
+            if (i % RANK_BLOCK_WORDS_PERFECT_HASH_TABLE == 0) ranks[i / RANK_BLOCK_WORDS_PERFECT_HASH_TABLE] = count;
+            count += popCount(bits[i]);
+        }
+        levelKeys = count;
+    }
+
+    // adds a level for keys, keys without collisions are removed
+    void addLevel(std::vector<KeyType>& keys, double gamma) {
+        const size_t level = levelSizes.size();
+        const uint64_t levelSize = std::max<uint64_t>(64, (uint64_t(gamma * keys.size()) + 63) & ~uint64_t(63));
+        std::vector<uint64_t> levelBits(size_t(levelSize / 64)), collisions(size_t(levelSize / 64));
+        for (KeyType key : keys) {
+            uint64_t bit = reduce(hash(key, level), levelSize);
+            if (getBit(levelBits, bit)) setBit(collisions, bit);
+            else setBit(levelBits, bit);
+        }
+        for (size_t i = 0; i < levelBits.size(); i++)
+            levelBits[i] &= ~collisions[i];
+
+        keys.erase(std::remove_if(keys.begin(), keys.end(), [&levelBits, level, levelSize](KeyType key) {
+            return getBit(levelBits, reduce(hash(key, level), levelSize));
+        }), keys.end());
+        levelOffsets.push_back(uint64_t(bits.size()) * 64);
+        levelSizes.push_back(levelSize);
+        bits.insert(bits.end(), levelBits.begin(), levelBits.end());
+    }
+
+    // returns getSize() if the key is not in the set of keys of the table
+    // for absent keys any index can be returned, the key of the element must be compared
+    size_t getIndex(KeyType key) const {
+        for (size_t level = 0; level < levelSizes.size(); level++) {
+            uint64_t bit = levelOffsets[level] + reduce(hash(key, level), levelSizes[level]);
+            if (getBit(bits, bit)) return getRank(bit);
+        }
+        auto it = std::lower_bound(fallbackKeys.begin(), fallbackKeys.end(), key);
+        if (it == fallbackKeys.end() || *it != key) return elements.size();
+        return levelKeys + size_t(it - fallbackKeys.begin());
+    }
+
+    template <class T>
+    static void write(std::ostream& ostr, const T& value) {
+        ostr.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <class T>
+    static void writeVector(std::ostream& ostr, const std::vector<T>& vector) {
+        write(ostr, uint64_t(vector.size()));
+        ostr.write(reinterpret_cast<const char*>(vector.data()), std::streamsize(vector.size() * sizeof(T)));
+    }
+
+    template <class T>
+    static void read(std::istream& istr, T& value) {
+        if (!istr.read(reinterpret_cast<char*>(&value), sizeof(T))) throw "Can't read perfect hash table";
+    }
+
+    // the size is read from the stream and can be corrupt, so the vector grows by chunks which are read,
+    // and a huge size fails at the end of the stream instead of allocating all its memory at once
+    template <class T>
+    static void readVector(std::istream& istr, std::vector<T>& vector) {
+        uint64_t size = 0;
+        read(istr, size);
+        if (size > std::numeric_limits<size_t>::max() / sizeof(T)) throw "Stream doesn't contain perfect hash table";
+        const size_t chunkSize = std::max(READ_CHUNK_BYTES_PERFECT_HASH_TABLE / sizeof(T), size_t(1));
+        vector.clear();
+        while (vector.size() < size) {
+            size_t begin = vector.size();
+            vector.resize(begin + size_t(std::min(size - begin, uint64_t(chunkSize))));
+            if (!istr.read(reinterpret_cast<char*>(vector.data() + begin), std::streamsize((vector.size() - begin) * sizeof(T))))
+                throw "Stream doesn't contain perfect hash table";
+        }
+    }
+
+    PerfectHashTable() {}
+
+public:
+
+    typedef ElemType elem_type;
+
+    // builds the table in O(n) on the average, throws if keys are repeated
+    PerfectHashTable(const std::vector<std::pair<KeyType, ElemType>>& elems,
+        double gamma = GAMMA_PERFECT_HASH_TABLE) {
+        if (!(gamma >= 1)) throw "Gamma must be at least 1";
+        std::vector<KeyType> keys(elems.size());
+        for (size_t i = 0; i < elems.size(); i++)
+            keys[i] = elems[i].first;
+        while (!keys.empty() && levelSizes.size() < MAX_LEVELS_PERFECT_HASH_TABLE)
+            addLevel(keys, gamma);  // repeated keys collide in all levels
+
+        std::sort(keys.begin(), keys.end());
+        if (std::adjacent_find(keys.begin(), keys.end()) != keys.end()) throw "Key is repeated";
+        fallbackKeys = keys;
+        computeRanks();
+
+        elements.resize(elems.size());
+        for (const std::pair<KeyType, ElemType>& elem : elems)
+            elements[getIndex(elem.first)] = elem;
+    }
+
+    // search O(1) on the average
+    const std::pair<KeyType, ElemType>* find(const KeyType& key) const {
+        size_t index = getIndex(key);
+        if (index >= elements.size() || elements[index].first != key) return nullptr;
+        return &elements[index];
+    }
+
+    // elements can be changed, keys must not be changed
+    std::pair<KeyType, ElemType>* find(const KeyType& key) {
+        return const_cast<std::pair<KeyType, ElemType>*>(static_cast<const PerfectHashTable&>(*this).find(key));
+    }
+
+    size_t getSize() const {
+        return elements.size();
+    }
+
+    bool isEmpty() const {
+        return elements.empty();
+    }
+
+    // bit arrays, ranks and fallback keys are metadata
+    MemoryUsage getMemoryUsage() const {
+        MemoryUsage res;
+        res.addArray(elements.capacity(), elements.size(), sizeof(std::pair<KeyType, ElemType>),
+            sizeof(std::pair<KeyType, ElemType>));
+        res.addArray(bits.capacity(), bits.size(), sizeof(uint64_t), 0);
+        res.addArray(ranks.capacity(), ranks.size(), sizeof(uint32_t), 0);
+        res.addArray(fallbackKeys.capacity(), fallbackKeys.size(), sizeof(KeyType), 0);
+        res.addArray(levelOffsets.capacity() + levelSizes.capacity(), levelOffsets.size() + levelSizes.size(),
+            sizeof(uint64_t), 0);
+        for (const std::pair<KeyType, ElemType>& elem : elements)
+            res.elementHeapBytes += getHeapBytes(elem.second);
+        return res;
+    }
+
+    // memory of the hash function per key, bits
+    double getBitsPerKey() const {
+        if (elements.empty()) return 0;
+        size_t bytes = bits.size() * sizeof(uint64_t) + ranks.size() * sizeof(uint32_t)
+            + fallbackKeys.size() * sizeof(KeyType) + (levelOffsets.size() + levelSizes.size()) * sizeof(uint64_t);
+        return 8.0 * bytes / elements.size();
+    }
+
+    size_t getLevelCount() const {
+        return levelSizes.size();
+    }
+
+    // binary format of the machine, elements are written as bytes
+    void save(std::ostream& ostr) const {
+        static_assert(std::is_trivially_copyable<ElemType>::value, "elements are saved as bytes");
+        write(ostr, MAGIC_PERFECT_HASH_TABLE);
+        write(ostr, uint32_t(sizeof(std::pair<KeyType, ElemType>)));
+        writeVector(ostr, bits);
+        writeVector(ostr, levelOffsets);
+        writeVector(ostr, levelSizes);
+        writeVector(ostr, fallbackKeys);
+        writeVector(ostr, elements);
+        if (!ostr) throw "Can't write perfect hash table";
+    }
+
+    // throws if the stream doesn't contain a table with the same type of elements
+    static PerfectHashTable load(std::istream& istr) {
+        static_assert(std::is_trivially_copyable<ElemType>::value, "elements are loaded as bytes");
+        uint32_t magic = 0, pairSize = 0;
+        read(istr, magic);
+        read(istr, pairSize);
+        if (magic != MAGIC_PERFECT_HASH_TABLE || pairSize != sizeof(std::pair<KeyType, ElemType>))
+            throw "Stream doesn't contain perfect hash table";
+
+        PerfectHashTable res;
+        readVector(istr, res.bits);
+        readVector(istr, res.levelOffsets);
+        readVector(istr, res.levelSizes);
+        readVector(istr, res.fallbackKeys);
+        readVector(istr, res.elements);
+        // levels are not empty and lie in the bit array, otherwise searches would read out of it
+        const uint64_t bitCount = uint64_t(res.bits.size()) * 64;
+        if (res.levelOffsets.size() != res.levelSizes.size()) throw "Stream doesn't contain perfect hash table";
+        for (size_t level = 0; level < res.levelSizes.size(); level++)
+            if (res.levelSizes[level] == 0 || res.levelOffsets[level] >= bitCount
+                || res.levelSizes[level] > bitCount - res.levelOffsets[level])
+                throw "Stream doesn't contain perfect hash table";
+        if (!std::is_sorted(res.fallbackKeys.begin(), res.fallbackKeys.end()))
+            throw "Stream doesn't contain perfect hash table";
+        res.computeRanks();
+        if (res.levelKeys + res.fallbackKeys.size() != res.elements.size())
+            throw "Stream doesn't contain perfect hash table";
+        return res;
+    }
+
+};
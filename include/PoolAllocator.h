@@ -0,0 +1,177 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+
+const size_t START_SLAB_SIZE_BLOCK_POOL = 8;  // number of blocks in the first slab
+const size_t MAX_SLAB_SIZE_BLOCK_POOL = 1024;  // slabs grow twice up to this number of blocks
+
+
+// pool of blocks of equal size
+// memory is allocated by slabs of several blocks, freed blocks are kept in a free list and reused
+// the block size is set by the first allocation
+// the pool is not thread-safe
+class BlockPool {
+    size_t blockSize = 0;
+    size_t nextSlabSize = START_SLAB_SIZE_BLOCK_POOL;
+    std::vector<char*> slabs;
+    char* current = nullptr;  // free part of the last slab is [current, end)
+    char* end = nullptr;
+    void* freeList = nullptr;  // freed blocks, every block contains pointer to the next one
+    size_t usedBlocks = 0;
+
+    void addSlab() {
+        char* slab = static_cast<char*>(::operator new(nextSlabSize * blockSize));
+        slabs.push_back(slab);
+        current = slab;
+        end = slab + nextSlabSize * blockSize;
+        if (nextSlabSize < MAX_SLAB_SIZE_BLOCK_POOL) nextSlabSize *= 2;
+    }
+
+public:
+
+    BlockPool() {}
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    ~BlockPool() {
+        release();
+    }
+
+    // returns true if an object with given size and alignment can be placed in a block
+    bool fits(size_t size, size_t alignment) const {
+        return blockSize == 0 || (size <= blockSize && blockSize % alignment == 0);
+    }
+
+    void* allocate(size_t size, size_t alignment) {
+        if (blockSize == 0) {
+            size_t align = alignment > alignof(void*) ? alignment : alignof(void*);
+            blockSize = (size > sizeof(void*) ? size : sizeof(void*)) + align - 1;
+            blockSize -= blockSize % align;
+        }
+        usedBlocks++;
+        if (freeList) {
+            void* block = freeList;
+            freeList = *static_cast<void**>(block);
+            return block;
+        }
+        if (current == end) addSlab();
+        void* block = current;
+        current += blockSize;
+        return block;
+    }
+
+    void deallocate(void* block) {
+        *static_cast<void**>(block) = freeList;
+        freeList = block;
+        usedBlocks--;
+    }
+
+    // frees all slabs at once, blocks must not be used after that
+    void release() {
+        for (char* slab : slabs)
+            ::operator delete(slab);
+        slabs.clear();
+        current = end = nullptr;
+        freeList = nullptr;
+        nextSlabSize = START_SLAB_SIZE_BLOCK_POOL;
+        usedBlocks = 0;
+    }
+
+    size_t getBlockSize() const {
+        return blockSize;
+    }
+
+    size_t getUsedBlocks() const {
+        return usedBlocks;
+    }
+
+    size_t getSlabsCount() const {
+        return slabs.size();
+    }
+};
+
+
+// allocator of single objects from BlockPool (for nodes of lists)
+// every default constructed allocator has its own pool created on the first use,
+// copies (including rebound ones) share the pool of the original allocator
+// allocations of several objects at once are passed to operator new
+template <class T>
+class PoolAllocator {
+    mutable std::shared_ptr<BlockPool> pool;
+
+    template <class U> friend class PoolAllocator;
+
+    bool isPoolAllocation(size_t n) const {
+        return n == 1 && getPool()->fits(sizeof(T), alignof(T));
+    }
+
+public:
+
+    typedef T value_type;
+
+    PoolAllocator() {}
+
+    PoolAllocator(const PoolAllocator& allocator) : pool(allocator.getPool()) {}
+
+    // does not create a pool, so containers can be moved without allocations
+    PoolAllocator(PoolAllocator&& allocator) noexcept : pool(std::move(allocator.pool)) {}
+
+    template <class U>
+    PoolAllocator(const PoolAllocator<U>& allocator) : pool(allocator.getPool()) {}
+
+    PoolAllocator& operator=(const PoolAllocator& allocator) {
+        pool = allocator.getPool();
+        return *this;
+    }
+
+    PoolAllocator& operator=(PoolAllocator&& allocator) noexcept {
+        pool = std::move(allocator.pool);
+        return *this;
+    }
+
+    const std::shared_ptr<BlockPool>& getPool() const {
+        if (!pool) pool = std::make_shared<BlockPool>();
+        return pool;
+    }
+
+    T* allocate(size_t n) {
+        if (isPoolAllocation(n))
+            return static_cast<T*>(pool->allocate(sizeof(T), alignof(T)));
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) {
+        if (isPoolAllocation(n))
+            pool->deallocate(ptr);
+        else
+            ::operator delete(ptr);
+    }
+
+    // frees slabs of the pool if it has no used blocks and is not shared with other allocators
+    void releaseUnusedMemory() {
+        if (pool && pool.use_count() == 1 && pool->getUsedBlocks() == 0)
+            pool->release();
+    }
+
+    template <class U>
+    friend bool operator==(const PoolAllocator& allocator1, const PoolAllocator<U>& allocator2) {
+        return allocator1.getPool() == allocator2.getPool();
+    }
+
+    template <class U>
+    friend bool operator!=(const PoolAllocator& allocator1, const PoolAllocator<U>& allocator2) {
+        return !(allocator1 == allocator2);
+    }
+};
+
+
+// lets containers give memory back without knowing the type of allocator
+template <class Allocator>
+void releaseUnusedMemory(Allocator&) {}
+
+template <class T>
+void releaseUnusedMemory(PoolAllocator<T>& allocator) {
+    allocator.releaseUnusedMemory();
+}
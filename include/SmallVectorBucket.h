@@ -0,0 +1,282 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+
+// forward iterator over elements of SmallVectorBucket, Value is T or const T
+template <class Bucket, class T, class Value = T>
+class SmallVectorBucketIterator {
+    Bucket* bucket;
+    size_t index;
+
+public:
+
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Value* pointer;
+    typedef Value& reference;
+
+    SmallVectorBucketIterator(Bucket* bucket = nullptr, size_t index = 0) : bucket(bucket), index(index) {}
+
+    Value& operator*() const {
+        return (*bucket)[index];
+    }
+
+    Value* operator->() const {
+        return &(*bucket)[index];
+    }
+
+    SmallVectorBucketIterator& operator++() {
+        index++;
+        return *this;
+    }
+
+    SmallVectorBucketIterator operator++(int) {
+        SmallVectorBucketIterator tmp = *this;
+        index++;
+        return tmp;
+    }
+
+    friend bool operator==(const SmallVectorBucketIterator& it1, const SmallVectorBucketIterator& it2) {
+        return it1.index == it2.index;
+    }
+
+    friend bool operator!=(const SmallVectorBucketIterator& it1, const SmallVectorBucketIterator& it2) {
+        return it1.index != it2.index;
+    }
+};
+
+
+// bucket for hash tables with separate chaining
+// the first InlineCapacity elements are stored inside of the bucket, the others are in an overflow array,
+// so short chains are read from the bucket array without following pointers
+// interface is the same as of List (pushFront, findFirst, eraseFirst, iteration)
+// elements are shifted on insertion and erasing, it is cheap for short chains
+template <class T, class Allocator = std::allocator<T>, size_t InlineCapacity = 2>
+class SmallVectorBucket : private Allocator {  // empty allocator takes no space
+    static_assert(InlineCapacity > 0, "Bucket must contain at least one inline element");
+
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    alignas(T) unsigned char inlineElements[InlineCapacity * sizeof(T)];
+    uint32_t count = 0;  // elements after the first InlineCapacity ones are in overflow
+    uint32_t overflowCapacity = 0;
+    T* overflow = nullptr;
+
+    Allocator& getAllocatorRef() {
+        return *this;
+    }
+
+    const Allocator& getAllocatorRef() const {
+        return *this;
+    }
+
+    T* getPointer(size_t index) {
+        return index < InlineCapacity ? reinterpret_cast<T*>(inlineElements) + index : overflow + (index - InlineCapacity);
+    }
+
+    // constructs element at the end, the overflow array grows twice
+    template <class... Args>
+    T* emplaceBack(Args&&... args) {
+        if (count >= InlineCapacity + overflowCapacity) {
+            uint32_t newCapacity = std::max<uint32_t>(2 * overflowCapacity, InlineCapacity);
+            T* newOverflow = AllocatorTraits::allocate(getAllocatorRef(), newCapacity);
+            for (uint32_t i = 0; i < overflowCapacity; i++) {
+                AllocatorTraits::construct(getAllocatorRef(), newOverflow + i, std::move(overflow[i]));
+                AllocatorTraits::destroy(getAllocatorRef(), overflow + i);
+            }
+            if (overflow) AllocatorTraits::deallocate(getAllocatorRef(), overflow, overflowCapacity);
+            overflow = newOverflow;
+            overflowCapacity = newCapacity;
+        }
+        T* ptr = getPointer(count);
+        AllocatorTraits::construct(getAllocatorRef(), ptr, std::forward<Args>(args)...);
+        count++;
+        return ptr;
+    }
+
+    void popBack() {
+        count--;
+        AllocatorTraits::destroy(getAllocatorRef(), getPointer(count));
+    }
+
+    T* moveLastToFront() {
+        for (size_t i = count - 1; i > 0; i--)
+            std::swap((*this)[i], (*this)[i - 1]);
+        return getPointer(0);
+    }
+
+    void freeOverflow() {
+        if (overflow) AllocatorTraits::deallocate(getAllocatorRef(), overflow, overflowCapacity);
+        overflow = nullptr;
+        overflowCapacity = 0;
+    }
+
+    // takes elements of the bucket, this bucket must be empty
+    // the overflow array is taken if it can be freed by allocator of this bucket
+    void moveFrom(SmallVectorBucket& bucket, bool canTakeOverflow) {
+        if (canTakeOverflow) {
+            for (uint32_t i = 0; i < std::min<uint32_t>(bucket.count, InlineCapacity); i++)
+                emplaceBack(std::move(bucket[i]));
+            count = bucket.count;
+            overflow = bucket.overflow;
+            overflowCapacity = bucket.overflowCapacity;
+            bucket.count = std::min<uint32_t>(bucket.count, InlineCapacity);
+            bucket.overflow = nullptr;
+            bucket.overflowCapacity = 0;
+        }
+        else {
+            for (uint32_t i = 0; i < bucket.count; i++)
+                emplaceBack(std::move(bucket[i]));
+        }
+        bucket.clear();
+    }
+
+public:
+
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef SmallVectorBucketIterator<SmallVectorBucket, T> iterator;
+    typedef SmallVectorBucketIterator<const SmallVectorBucket, T, const T> const_iterator;
+
+    SmallVectorBucket() {}
+
+    explicit SmallVectorBucket(const Allocator& allocator) : Allocator(allocator) {}
+
+    SmallVectorBucket(const SmallVectorBucket& bucket) :
+        Allocator(AllocatorTraits::select_on_container_copy_construction(bucket.getAllocatorRef())) {
+        for (const T& data : bucket)
+            emplaceBack(data);
+    }
+
+    SmallVectorBucket(SmallVectorBucket&& bucket) noexcept : Allocator(std::move(bucket.getAllocatorRef())) {
+        moveFrom(bucket, true);
+    }
+
+    ~SmallVectorBucket() {
+        clear();
+    }
+
+    SmallVectorBucket& operator=(const SmallVectorBucket& bucket) {
+        if (&bucket != this) {
+            clear();
+            for (const T& data : bucket)
+                emplaceBack(data);
+        }
+        return *this;
+    }
+
+    SmallVectorBucket& operator=(SmallVectorBucket&& bucket) {
+        if (&bucket != this) {
+            clear();
+            moveFrom(bucket, getAllocatorRef() == bucket.getAllocatorRef());
+        }
+        return *this;
+    }
+
+    T& operator[](size_t index) {
+        return *getPointer(index);
+    }
+
+    const T& operator[](size_t index) const {
+        return const_cast<SmallVectorBucket*>(this)->operator[](index);
+    }
+
+    size_t getSize() const {
+        return count;
+    }
+
+    // number of elements which fit into the bucket and the overflow array
+    size_t getCapacity() const {
+        return InlineCapacity + overflowCapacity;
+    }
+
+    // memory of the overflow array, bytes
+    size_t getAllocatedBytes() const {
+        return overflowCapacity * sizeof(T);
+    }
+
+    iterator begin() {
+        return iterator(this, 0);
+    }
+
+    iterator end() {
+        return iterator(this, count);
+    }
+
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, count);
+    }
+
+    T* pushFront(const T& data) {  // returns pointer to new element
+        emplaceBack(data);
+        return moveLastToFront();
+    }
+
+    T* pushFront(T&& data) {  // returns pointer to new element
+        emplaceBack(std::move(data));
+        return moveLastToFront();
+    }
+
+    T* pushBack(const T& data) {  // returns pointer to new element
+        return emplaceBack(data);
+    }
+
+    // moves every element to the front of bucket getBucket(element), O(n)
+    // elements are moved, not copied, this bucket becomes empty
+    template <class GetBucket>
+    void moveAllTo(GetBucket getBucket) {
+        for (size_t i = 0; i < count; i++)
+            getBucket((*this)[i]).pushFront(std::move((*this)[i]));
+        clear();
+    }
+
+    // returns pointer to the first element satisfying predicate or nullptr
+    template <class Predicate>
+    T* findFirst(Predicate predicate) {
+        const size_t inlineCount = std::min<size_t>(count, InlineCapacity);
+        T* inlinePtr = reinterpret_cast<T*>(inlineElements);
+        for (size_t i = 0; i < inlineCount; i++)
+            if (predicate(inlinePtr[i])) return inlinePtr + i;
+        for (size_t i = InlineCapacity; i < count; i++)
+            if (predicate(overflow[i - InlineCapacity])) return overflow + (i - InlineCapacity);
+        return nullptr;
+    }
+
+    // erases the first element satisfying predicate, the next elements are shifted
+    // returns true if element was erased
+    template <class Predicate>
+    bool eraseFirst(Predicate predicate) {
+        for (size_t i = 0; i < count; i++)
+            if (predicate((*this)[i])) {
+                for (size_t j = i + 1; j < count; j++)
+                    (*this)[j - 1] = std::move((*this)[j]);
+                popBack();
+                return true;
+            }
+        return false;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    // the overflow array is freed
+    void clear() {
+        while (count) popBack();
+        freeOverflow();
+    }
+
+    allocator_type getAllocator() const {
+        return getAllocatorRef();
+    }
+};
@@ -0,0 +1,126 @@
+#pragma once
+#include "Table.h"
+
+#include <cstdint>
+#include <initializer_list>
+
+
+// element of StaticHashTable, it is a pair (key, element) which can be changed in constexpr functions
+// (std::pair can't be assigned there before C++20)
+template <class ElemType>
+struct StaticHashTableEntry {
+    KeyType first;
+    ElemType second;
+};
+
+
+// open addressing table with fixed capacity for keys and elements known at compile time
+// (protocol codes, feature ids), a constexpr table is built by the compiler and is kept in read-only data,
+// so it has no startup cost and no heap memory, and searches of constant keys are computed at compile time
+// ElemType must be a literal type with default constructor (numbers, enums, const char*, literal structs)
+// storage size is the least power of 2 not less than 2 * Capacity, the hash function is fixed
+// and probing is linear, so a search ends at an empty cell which always exists
+// errors (too many elements, repeated keys) are exceptions, in constant expressions they are compile errors
+template <class ElemType, size_t Capacity>
+class StaticHashTable {
+
+public:
+
+    using Entry = StaticHashTableEntry<ElemType>;
+
+    static constexpr size_t getStorageSizeDeg() {
+        size_t deg = 1;
+        while ((size_t(1) << deg) < 2 * Capacity) deg++;
+        return deg;
+    }
+
+    static constexpr size_t getStorageSize() {
+        return size_t(1) << getStorageSizeDeg();
+    }
+
+private:
+
+    // multiply-shift hash with the golden ratio multiplier,
+    // there is no random parameter because keys are not chosen by users
+    static constexpr size_t hash(KeyType key) {
+        return size_t(uint32_t(key * uint32_t(2654435769u)) >> (32 - getStorageSizeDeg()));
+    }
+
+    Entry entries[getStorageSize()] = {};
+    bool occupied[getStorageSize()] = {};
+    size_t size = 0;
+
+    // returns the cell with the key or the empty cell where the key should be
+    constexpr size_t findIndex(KeyType key) const {
+        size_t index = hash(key);
+        while (occupied[index] && entries[index].first != key)
+            index = (index + 1) & (getStorageSize() - 1);
+        return index;
+    }
+
+public:
+
+    constexpr StaticHashTable() {}
+
+    // throws if keys are repeated or there are more than Capacity elements
+    constexpr StaticHashTable(std::initializer_list<Entry> list) {
+        for (const Entry& entry : list)
+            if (!insert(entry.first, entry.second)) throw "Key is repeated";
+    }
+
+    // tables are filled in constexpr functions too, returns false if the key exists
+    constexpr bool insert(KeyType key, const ElemType& elem) {
+        size_t index = findIndex(key);
+        if (occupied[index]) return false;
+        if (size == Capacity) throw "Table is full";
+        entries[index].first = key;
+        entries[index].second = elem;
+        occupied[index] = true;
+        size++;
+        return true;
+    }
+
+    // search O(1) on the average, returns nullptr if the key does not exist
+    constexpr const Entry* find(KeyType key) const {
+        size_t index = findIndex(key);
+        return occupied[index] ? &entries[index] : nullptr;
+    }
+
+    constexpr bool contains(KeyType key) const {
+        return occupied[findIndex(key)];
+    }
+
+    // throws if the key does not exist
+    constexpr const ElemType& at(KeyType key) const {
+        size_t index = findIndex(key);
+        if (!occupied[index]) throw "Key does not exist";
+        return entries[index].second;
+    }
+
+    constexpr size_t getSize() const {
+        return size;
+    }
+
+    constexpr bool isEmpty() const {
+        return size == 0;
+    }
+
+    // flags are metadata, empty cells are slack
+    MemoryUsage getMemoryUsage() const {
+        MemoryUsage res;
+        res.addArray(getStorageSize(), size, sizeof(Entry) + sizeof(bool), sizeof(Entry));
+        return res;
+    }
+
+};
+
+
+// capacity is the number of entries, e.g.
+//     constexpr auto table = makeStaticHashTable<int>({ { 1, 10 }, { 2, 20 } });
+template <class ElemType, size_t N>
+constexpr StaticHashTable<ElemType, N> makeStaticHashTable(const StaticHashTableEntry<ElemType> (&list)[N]) {
+    StaticHashTable<ElemType, N> table;
+    for (size_t i = 0; i < N; i++)
+        if (!table.insert(list[i].first, list[i].second)) throw "Key is repeated";
+    return table;
+}
@@ -1,27 +1,194 @@
 #pragma once
+#include "HashTableStatistics.h"
+#include "MemoryUsage.h"
+
+#include <algorithm>
+#include <memory>
 #include <vector>
 #include <random>
+#include <type_traits>
+#include <utility>
 
 
 typedef uint32_t KeyType;
 
 
-template <class ElemType>
-class TableInterface {
+// compile-time interface of tables (CRTP), Derived is a table type
+// all tables derive from it and define
+//     bool insert(const KeyType& key, const ElemType& elem)  - returns true if elem was inserted
+//     bool erase(const KeyType& key)  - returns true if elem was deleted
+//     std::pair<KeyType, ElemType>* find(const KeyType& key)  - returns nullptr if elem was not found
+//     std::pair<std::pair<KeyType, ElemType>*, bool> findOrInsert(const KeyType& key, const ElemType& elem)
+//         - returns pointer to element with the key and true if elem was inserted,
+//           elem is inserted only if the key does not exist, the table is searched once
+//     void clear(), bool isEmpty() const, size_t getSize() const
+//     MemoryUsage getMemoryUsage() const  - memory of the table and heap memory of elements
+// these functions are not virtual, so templates over table types call them directly and can inline them
+template <class Derived, class ElemType>
+class StaticTableInterface {
+
+    Derived& derived() {
+        return static_cast<Derived&>(*this);
+    }
+
 public:
 
+    typedef ElemType elem_type;
+
+    // returns element with the key, default element is inserted if the key does not exist
+    ElemType& getOrInsert(const KeyType& key) {
+        return derived().findOrInsert(key, ElemType()).first->second;
+    }
+
+    // inserts elem or replaces existing element with the key
     // returns true if elem was inserted
-    virtual bool insert(const KeyType& key, const ElemType& elem) = 0;
+    bool upsert(const KeyType& key, const ElemType& elem) {
+        std::pair<std::pair<KeyType, ElemType>*, bool> res = derived().findOrInsert(key, elem);
+        if (!res.second) res.first->second = elem;
+        return res.second;
+    }
 
-    // returns true if elem was deleted
-    virtual bool erase(const KeyType& key) = 0;
+    // calls function(ElemType&) for element with the key in one search,
+    // default element is inserted if the key does not exist
+    // returns true if element was inserted
+    template <class Function>
+    bool update(const KeyType& key, Function function) {
+        std::pair<std::pair<KeyType, ElemType>*, bool> res = derived().findOrInsert(key, ElemType());
+        function(res.first->second);
+        return res.second;
+    }
+
+};
+
+
+// read side of TableInterface, it is implemented by read-only tables too (see ReadableTableAdapter)
+template <class ElemType>
+class ReadableTableInterface {
+public:
+
+    virtual ~ReadableTableInterface() {}
 
-    // returns nullptr if elem was not found
     virtual std::pair<KeyType, ElemType>* find(const KeyType& key) = 0;
 
-    virtual void clear() = 0;
     virtual bool isEmpty() const = 0;
     virtual size_t getSize() const = 0;
+    virtual MemoryUsage getMemoryUsage() const = 0;
+
+};
+
+
+// runtime interface of tables, for code which chooses table type at runtime
+// tables don't derive from it, they are wrapped by TableAdapter
+template <class ElemType>
+class TableInterface : public ReadableTableInterface<ElemType>,
+    public StaticTableInterface<TableInterface<ElemType>, ElemType> {
+public:
+
+    virtual bool insert(const KeyType& key, const ElemType& elem) = 0;
+    virtual bool erase(const KeyType& key) = 0;
+    virtual std::pair<std::pair<KeyType, ElemType>*, bool> findOrInsert(const KeyType& key, const ElemType& elem) = 0;
+
+    virtual void clear() = 0;
+
+};
+
+
+// implements TableInterface by a table of type TableType
+template <class TableType>
+class TableAdapter : public TableInterface<typename TableType::elem_type> {
+
+    using ElemType = typename TableType::elem_type;
+
+    TableType table;
+
+public:
+
+    TableAdapter() = default;
+
+    // arguments are passed to the constructor of the table, an adapter as the only argument is copied,
+    // it is not passed to the table
+    template <class FirstArg, class... Args,
+        class = typename std::enable_if<!std::is_same<typename std::decay<FirstArg>::type, TableAdapter>::value>::type>
+    explicit TableAdapter(FirstArg&& firstArg, Args&&... args) :
+        table(std::forward<FirstArg>(firstArg), std::forward<Args>(args)...) {}
+
+    TableType& getTable() {
+        return table;
+    }
+
+    bool insert(const KeyType& key, const ElemType& elem) override {
+        return table.insert(key, elem);
+    }
+
+    bool erase(const KeyType& key) override {
+        return table.erase(key);
+    }
+
+    std::pair<KeyType, ElemType>* find(const KeyType& key) override {
+        return table.find(key);
+    }
+
+    std::pair<std::pair<KeyType, ElemType>*, bool> findOrInsert(const KeyType& key, const ElemType& elem) override {
+        return table.findOrInsert(key, elem);
+    }
+
+    void clear() override {
+        table.clear();
+    }
+
+    bool isEmpty() const override {
+        return table.isEmpty();
+    }
+
+    size_t getSize() const override {
+        return table.getSize();
+    }
+
+    MemoryUsage getMemoryUsage() const override {
+        return table.getMemoryUsage();
+    }
+
+};
+
+
+// implements ReadableTableInterface by a table of type TableType, the table may have no modifying functions
+template <class TableType>
+class ReadableTableAdapter : public ReadableTableInterface<typename TableType::elem_type> {
+
+    using ElemType = typename TableType::elem_type;
+
+    TableType table;
+
+public:
+
+    ReadableTableAdapter() = default;
+
+    // arguments are passed to the constructor of the table, an adapter as the only argument is copied,
+    // it is not passed to the table
+    template <class FirstArg, class... Args,
+        class = typename std::enable_if<!std::is_same<typename std::decay<FirstArg>::type, ReadableTableAdapter>::value>::type>
+    explicit ReadableTableAdapter(FirstArg&& firstArg, Args&&... args) :
+        table(std::forward<FirstArg>(firstArg), std::forward<Args>(args)...) {}
+
+    TableType& getTable() {
+        return table;
+    }
+
+    std::pair<KeyType, ElemType>* find(const KeyType& key) override {
+        return table.find(key);
+    }
+
+    bool isEmpty() const override {
+        return table.isEmpty();
+    }
+
+    size_t getSize() const override {
+        return table.getSize();
+    }
+
+    MemoryUsage getMemoryUsage() const override {
+        return table.getMemoryUsage();
+    }
 
 };
 
@@ -29,32 +196,88 @@ public:
 const double REPACK_COEFF = 1.3;
 const size_t START_STORAGE_SIZE = 10;
 
-template <class ElemType, class CellType = std::pair<KeyType, ElemType>>
-class TableByArray : public TableInterface<ElemType> {
+// growth of the storage of tables by arrays, it is set for each table
+// a small factor saves memory, a large one makes fewer repacks
+struct GrowthPolicy {
+    size_t startStorageSize = START_STORAGE_SIZE;  // also the storage size after clear()
+    double growthFactor = REPACK_COEFF;            // storage size is multiplied by it on repack
+
+    void check() const {
+        if (!(growthFactor > 1)) throw "Growth factor must be greater than 1";
+    }
+};
+
+// allocator of the same family as Allocator for objects of type T
+template <class Allocator, class T>
+using RebindAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+
+// Allocator is an allocator of pairs (key, element), it is rebound to CellType for the storage
+template <class ElemType, class CellType = std::pair<KeyType, ElemType>,
+    class Allocator = std::allocator<std::pair<KeyType, ElemType>>>
+class TableByArray {
 protected:
 
-    std::vector<CellType> storage;
+    using Storage = std::vector<CellType, RebindAllocator<Allocator, CellType>>;
+
+    Storage storage;
     size_t size = 0;
+    GrowthPolicy growthPolicy;
 
-    void repack() {  // re-allocates memory
-        storage.resize(size_t(storage.size()*REPACK_COEFF));
+    void repack() {  // re-allocates memory, the storage grows at least by one cell
+        storage.resize(std::max(storage.size() + 1, size_t(storage.size()*growthPolicy.growthFactor)));
+    }
+
+    // memory of the storage whose first size cells contain elements,
+    // the other cells can keep erased elements with their heap memory, it is counted
+    MemoryUsage getPackedMemoryUsage() const {
+        MemoryUsage res;
+        res.addArray(storage.capacity(), size, sizeof(CellType), sizeof(CellType));
+        for (const CellType& cell : storage)
+            res.elementHeapBytes += getHeapBytes(cell.second);
+        return res;
     }
 
 public:
 
-    TableByArray(size_t storageSize = START_STORAGE_SIZE) : storage(storageSize) {}
+    TableByArray(size_t storageSize = START_STORAGE_SIZE, const Allocator& allocator = Allocator()) :
+        storage(storageSize, typename Storage::allocator_type(allocator)) {}
 
-    void clear() override {
-        std::vector<CellType> tmp(START_STORAGE_SIZE);
+    // cells are copies of emptyCell, for cells without default constructor
+    TableByArray(size_t storageSize, const CellType& emptyCell, const Allocator& allocator) :
+        storage(storageSize, emptyCell, typename Storage::allocator_type(allocator)) {}
+
+    TableByArray(const GrowthPolicy& growthPolicy, const Allocator& allocator = Allocator()) :
+        storage(growthPolicy.startStorageSize, typename Storage::allocator_type(allocator)),
+        growthPolicy(growthPolicy) {
+        growthPolicy.check();
+    }
+
+    void clear() {
+        Storage tmp(growthPolicy.startStorageSize, storage.get_allocator());
         std::swap(tmp, storage);
         size = 0;
     }
 
-    size_t getSize() const override {
+    Allocator getAllocator() const {
+        return Allocator(storage.get_allocator());
+    }
+
+    const GrowthPolicy& getGrowthPolicy() const {
+        return growthPolicy;
+    }
+
+    // the new policy is used by next repacks, the start size is used by clear()
+    void setGrowthPolicy(const GrowthPolicy& newPolicy) {
+        newPolicy.check();
+        growthPolicy = newPolicy;
+    }
+
+    size_t getSize() const {
         return size;
     }
 
-    bool isEmpty() const override {
+    bool isEmpty() const {
         return size == 0;
     }
 
@@ -63,17 +286,58 @@ public:
 
 const size_t START_STORAGE_SIZE_DEG_HASH_TABLE = 4;  // start storage size = 2^4 = 16
 const double MAX_FILL_FACTOR_HASH_TABLE = 0.7;
+const double MAX_TOMBSTONE_FACTOR_HASH_TABLE = 0.25;
+const size_t MAX_PROBE_LENGTH_HASH_TABLE = 64;
+
+// load and growth of hash tables, it is set for each table
+// storage sizes are powers of 2, so the growth factor is 2^growthDeg
+// a high load factor saves memory, a low one makes searches shorter
+struct HashTablePolicy {
+    size_t startStorageSizeDeg = START_STORAGE_SIZE_DEG_HASH_TABLE;  // also the storage size after clear()
+    size_t growthDeg = 1;
+    double maxLoadFactor = MAX_FILL_FACTOR_HASH_TABLE;  // values greater than 1 suit separate chaining only
+    // open addressing is rehashed without growth when deleted cells take this part of the storage,
+    // maxLoadFactor + maxTombstoneFactor <= 1 keeps empty cells which stop unsuccessful searches
+    double maxTombstoneFactor = MAX_TOMBSTONE_FACTOR_HASH_TABLE;
+    // longer probe sequences (or chains) of insertions cause reseed, see HashTable::needsReseed
+    size_t maxProbeLength = MAX_PROBE_LENGTH_HASH_TABLE;
+
+    void check() const {
+        if (growthDeg == 0) throw "Growth degree must be positive";
+        if (!(maxLoadFactor > 0)) throw "Max load factor must be positive";
+        if (!(maxTombstoneFactor > 0 && maxTombstoneFactor <= 1)) throw "Max tombstone factor must be in (0, 1]";
+        if (maxProbeLength == 0) throw "Max probe length must be positive";
+    }
 
-// base class for hash tables
-// defines hash function
-template <class ElemType, class CellType>
-class HashTable : public TableByArray<ElemType, CellType> {
+    // start storage size is the least one which keeps capacity elements without repack
+    void setStartCapacity(size_t capacity) {
+        startStorageSizeDeg = 0;
+        while (startStorageSizeDeg + 1 < sizeof(size_t) * 8 &&
+            size_t(maxLoadFactor * (size_t(1) << startStorageSizeDeg)) < capacity)
+            startStorageSizeDeg++;
+    }
+};
+
+// pair (key, element) with cached full hash of the key, it can be used as a cell of hash tables
+// tables don't compute hashes on repack and compare hashes before keys on search
+template <class ElemType>
+struct HashedPair : public std::pair<KeyType, ElemType> {
+    uint32_t hash = 0;
+
+    HashedPair() {}
+    HashedPair(const KeyType& key, const ElemType& elem) : std::pair<KeyType, ElemType>(key, elem) {}
+};
+
+
+// universal hash function for keys of hash tables
+// maps keys to [0, 2^M)
+class HashFunction {
 
 protected:
 
     size_t M = START_STORAGE_SIZE_DEG_HASH_TABLE;  // storage size is 2^M
 
-    size_t getStorageSize(size_t M) {  // returns 2^M
+    static size_t getStorageSize(size_t M) {  // returns 2^M
         return size_t(1) << M;
     }
 
@@ -83,30 +347,161 @@ protected:
     // "a" is a random parameter of the universal hash function
     size_t a;
 
+    // generator of hash parameters, it is seeded by std::random_device once per thread,
+    // tests can seed it again to get the same parameters after reseeds
+    static std::default_random_engine& getHashParameterGenerator() {
+        thread_local std::default_random_engine randGen(std::random_device{}());
+        return randGen;
+    }
+
     void setHashParameter() {
-        std::random_device rd;
-        std::default_random_engine randGen(rd());
         std::uniform_int_distribution<uint32_t> dist;
-        a = (size_t)dist(randGen);
+        a = (size_t)(dist(getHashParameterGenerator()) | 1);  // odd multiplier maps different keys to different full hashes
     }
 
     // universal hash function that can be computed fast
     size_t hash(KeyType key) {
-        return (size_t)((uint32_t)(a * (uint64_t)key) >> (W - M));
+        return reduceHash(fullHash(key));
     }
 
-public:
+    // hash before taking the high M bits, it doesn't depend on the storage size
+    uint32_t fullHash(KeyType key) {
+        return (uint32_t)(a * (uint64_t)key);
+    }
+
+    size_t reduceHash(uint32_t fullHashValue) {
+        return (size_t)(fullHashValue >> (W - M));
+    }
+
+    // functions for cells with and without cached hash
+    template <class ElemType>
+    uint32_t getFullHash(const std::pair<KeyType, ElemType>& cell) {
+        return fullHash(cell.first);
+    }
+
+    template <class ElemType>
+    uint32_t getFullHash(const HashedPair<ElemType>& cell) {
+        return cell.hash;
+    }
+
+    template <class ElemType>
+    static void setCachedHash(std::pair<KeyType, ElemType>&, uint32_t) {}
+
+    template <class ElemType>
+    static void setCachedHash(HashedPair<ElemType>& cell, uint32_t fullHashValue) {
+        cell.hash = fullHashValue;
+    }
 
-    HashTable(size_t M = START_STORAGE_SIZE_DEG_HASH_TABLE) :
-        M(M), TableByArray<ElemType, CellType>(getStorageSize(M)) {
+    // cell can contain the key only if hashes are equal
+    template <class ElemType>
+    static bool mayContainKey(const std::pair<KeyType, ElemType>&, uint32_t) {
+        return true;
+    }
+
+    template <class ElemType>
+    static bool mayContainKey(const HashedPair<ElemType>& cell, uint32_t fullHashValue) {
+        return cell.hash == fullHashValue;
+    }
+
+    HashFunction(size_t M = START_STORAGE_SIZE_DEG_HASH_TABLE) : M(M) {
         setHashParameter();
     }
 
-    void clear() override {
-        TableByArray<ElemType, CellType>::clear();
-        M = START_STORAGE_SIZE_DEG_HASH_TABLE;
+};
+
+
+// base class for hash tables
+// defines hash function
+// Statistics is NoHashTableStatistics or HashTableStatisticsCollector to count probes and repacks,
+// it is a base class, so empty NoHashTableStatistics takes no memory in tables
+template <class ElemType, class CellType, class Statistics = NoHashTableStatistics,
+    class Allocator = std::allocator<std::pair<KeyType, ElemType>>>
+class HashTable : protected Statistics, public TableByArray<ElemType, CellType, Allocator>, public HashFunction {
+
+protected:
+
+    HashTablePolicy hashTablePolicy;
+    size_t insertionsSinceReseed = 0;
+
+    Statistics& statistics() {
+        return *this;
+    }
+
+    const Statistics& statistics() const {
+        return *this;
+    }
+
+    // repack is needed before insertion
+    bool isOverloaded() const {
+        return size >= size_t(hashTablePolicy.maxLoadFactor * storage.size());
+    }
+
+    // a long probe sequence (or chain) of insertion means that keys collide under the hash parameter,
+    // e.g. they were chosen to flood the table; reseed is allowed only if the table was filled enough
+    // since the last one, so rehashes take O(1) amortized time even if probes are long anyway
+    bool needsReseed(size_t probeLength) const {
+        return probeLength > hashTablePolicy.maxProbeLength && insertionsSinceReseed >= size / 2;
+    }
+
+    // new random hash parameter, derived tables rehash elements after that
+    void changeHashParameter() {
+        setHashParameter();
+        insertionsSinceReseed = 0;
+        statistics().recordReseed();
+    }
+
+    // statistics which don't depend on the type of cells
+    HashTableStatistics getCommonStatistics() const {
+        HashTableStatistics res;
+        statistics().exportTo(res);
+        res.size = size;
+        res.storageSize = storage.size();
+        res.storageBytes = storage.capacity() * sizeof(CellType);
+        res.loadFactor = storage.empty() ? 0 : double(size) / storage.size();
+        return res;
+    }
+
+public:
+
+    HashTable(size_t M = START_STORAGE_SIZE_DEG_HASH_TABLE, const Allocator& allocator = Allocator()) :
+        TableByArray<ElemType, CellType, Allocator>(getStorageSize(M), allocator), HashFunction(M) {}
+
+    HashTable(size_t M, const CellType& emptyCell, const Allocator& allocator) :
+        TableByArray<ElemType, CellType, Allocator>(getStorageSize(M), emptyCell, allocator), HashFunction(M) {}
+
+    HashTable(const HashTablePolicy& hashTablePolicy, const Allocator& allocator = Allocator()) :
+        TableByArray<ElemType, CellType, Allocator>(getStorageSize(hashTablePolicy.startStorageSizeDeg), allocator),
+        HashFunction(hashTablePolicy.startStorageSizeDeg), hashTablePolicy(hashTablePolicy) {
+        hashTablePolicy.check();
+    }
+
+    HashTable(const HashTablePolicy& hashTablePolicy, const CellType& emptyCell, const Allocator& allocator) :
+        TableByArray<ElemType, CellType, Allocator>(getStorageSize(hashTablePolicy.startStorageSizeDeg),
+            emptyCell, allocator),
+        HashFunction(hashTablePolicy.startStorageSizeDeg), hashTablePolicy(hashTablePolicy) {
+        hashTablePolicy.check();
+    }
+
+    void clear() {
+        TableByArray<ElemType, CellType, Allocator>::clear();
+        M = hashTablePolicy.startStorageSizeDeg;
         storage.resize(getStorageSize(M));
+        insertionsSinceReseed = 0;
     }
 
-};
+    const HashTablePolicy& getHashTablePolicy() const {
+        return hashTablePolicy;
+    }
 
+    // the new policy is used by next insertions, the start size is used by clear()
+    void setHashTablePolicy(const HashTablePolicy& newPolicy) {
+        newPolicy.check();
+        hashTablePolicy = newPolicy;
+    }
+
+    // counters of searches and repacks start from zero
+    void resetStatistics() {
+        statistics().reset();
+    }
+
+};
@@ -1,54 +1,184 @@
 #pragma once
 #include "Table.h"
+#include "Intrinsics.h"
 
+#include <algorithm>
 
-template <class ElemType>
-class UnorderedTable : public TableByArray<ElemType> {
+
+// how UnorderedTable reorders elements after successful search,
+// so that frequently requested keys are found faster
+enum class SelfOrganizingPolicy {
+    NONE,
+    MOVE_TO_FRONT,  // found element becomes the first one
+    TRANSPOSE,      // found element is swapped with the previous one
+    COUNT           // elements are sorted by the number of successful searches
+};
+
+
+// keys are duplicated in a separate array (struct of arrays),
+// so linear search reads only keys and compares several of them per instruction
+// all arrays are allocated by Allocator rebound to their types
+template <class ElemType, class Allocator = std::allocator<std::pair<KeyType, ElemType>>>
+class UnorderedTable : public TableByArray<ElemType, std::pair<KeyType, ElemType>, Allocator>,
+    public StaticTableInterface<UnorderedTable<ElemType, Allocator>, ElemType> {
+
+    using BaseClass = TableByArray<ElemType, std::pair<KeyType, ElemType>, Allocator>;
+    using Keys = std::vector<KeyType, RebindAllocator<Allocator, KeyType>>;
+    using Counts = std::vector<size_t, RebindAllocator<Allocator, size_t>>;
+
+    Keys keys;  // keys[i] == storage[i].first, the size is rounded up for SIMD search
+
+    SelfOrganizingPolicy policy = SelfOrganizingPolicy::NONE;
+    Counts counts;  // numbers of successful searches, used by COUNT policy only
+
+    static size_t getKeysSize(size_t storageSize) {
+        return (storageSize + FIND_FIRST_EQUAL_BLOCK_SIZE - 1) / FIND_FIRST_EQUAL_BLOCK_SIZE * FIND_FIRST_EQUAL_BLOCK_SIZE;
+    }
 
     // linear search O(n)
     // returns position to insert
     size_t linearSearch(const KeyType& key) {
-        size_t index = 0;
-        for (; index < size; index++)
-            if (storage[index].first == key) break;
-        return index;
+        return findFirstEqual(keys.data(), size, key);
+    }
+
+    void repack() {
+        BaseClass::repack();
+        keys.resize(getKeysSize(storage.size()));
+        if (policy == SelfOrganizingPolicy::COUNT) counts.resize(storage.size());
+    }
+
+    void swapElements(size_t i, size_t j) {
+        std::swap(storage[i], storage[j]);
+        std::swap(keys[i], keys[j]);
+        if (policy == SelfOrganizingPolicy::COUNT) std::swap(counts[i], counts[j]);
+    }
+
+    // moves found element to the beginning according to the policy
+    // returns new position of the element
+    size_t reorder(size_t index) {
+        switch (policy) {
+        case SelfOrganizingPolicy::MOVE_TO_FRONT: {
+            if (index == 0) return 0;
+            std::pair<KeyType, ElemType> elem = std::move(storage[index]);
+            std::move_backward(storage.begin(), storage.begin() + index, storage.begin() + index + 1);
+            std::move_backward(keys.begin(), keys.begin() + index, keys.begin() + index + 1);
+            storage[0] = std::move(elem);
+            keys[0] = storage[0].first;
+            return 0;
+        }
+        case SelfOrganizingPolicy::TRANSPOSE:
+            if (index == 0) return 0;
+            swapElements(index, index - 1);
+            return index - 1;
+        case SelfOrganizingPolicy::COUNT:
+            counts[index]++;
+            for (; index > 0 && counts[index - 1] < counts[index]; index--)
+                swapElements(index, index - 1);
+            return index;
+        default:
+            return index;
+        }
+    }
+
+    // appends element if key does not exist
+    // returns index of element with the key and true if element was inserted
+    std::pair<size_t, bool> insertIndex(const KeyType& key, const ElemType& elem) {
+        size_t searchRes = linearSearch(key);
+        if (searchRes != size)  // key already exists
+            return std::make_pair(searchRes, false);
+
+        if (storage.size() == size) repack();
+
+        storage[size] = std::make_pair(key, elem);
+        keys[size] = key;
+        if (policy == SelfOrganizingPolicy::COUNT) counts[size] = 0;
+        size++;
+
+        return std::make_pair(size - 1, true);
     }
 
 public:
 
+    UnorderedTable(size_t storageSize = START_STORAGE_SIZE,
+        SelfOrganizingPolicy policy = SelfOrganizingPolicy::NONE, const Allocator& allocator = Allocator()) :
+        BaseClass(storageSize, allocator),
+        keys(getKeysSize(storageSize), KeyType(), typename Keys::allocator_type(allocator)),
+        counts(typename Counts::allocator_type(allocator)) {
+        setPolicy(policy);
+    }
+
+    UnorderedTable(const GrowthPolicy& growthPolicy,
+        SelfOrganizingPolicy policy = SelfOrganizingPolicy::NONE, const Allocator& allocator = Allocator()) :
+        BaseClass(growthPolicy, allocator),
+        keys(getKeysSize(growthPolicy.startStorageSize), KeyType(), typename Keys::allocator_type(allocator)),
+        counts(typename Counts::allocator_type(allocator)) {
+        setPolicy(policy);
+    }
+
     // linear search O(n)
-    std::pair<KeyType, ElemType>* find(const KeyType& key) override {
+    // if the policy is not NONE, elements are reordered
+    // and pointers returned before may point to other elements
+    std::pair<KeyType, ElemType>* find(const KeyType& key) {
         size_t searchRes = linearSearch(key);
         if (searchRes == size)
             return nullptr;
-        return &(storage[searchRes]);
+        return &(storage[reorder(searchRes)]);
     }
 
     // insertion O(n) + O(1)
-    bool insert(const KeyType& key, const ElemType& elem) override {
-        size_t searchRes = linearSearch(key);
-        if (searchRes != size && storage[searchRes].first == key)  // key already exists
-            return false;
-
-        if (storage.size() == size) repack();
-        
-        storage[size] = std::make_pair(key, elem);
-        size++;
+    bool insert(const KeyType& key, const ElemType& elem) {
+        return insertIndex(key, elem).second;
+    }
 
-        return true;
+    // search O(n) and insertion O(1) if key does not exist
+    // found element is reordered as in find
+    std::pair<std::pair<KeyType, ElemType>*, bool> findOrInsert(const KeyType& key, const ElemType& elem) {
+        std::pair<size_t, bool> res = insertIndex(key, elem);
+        size_t index = res.second ? res.first : reorder(res.first);
+        return std::make_pair(&(storage[index]), res.second);
     }
 
-    // erasing O(n) + O(1)
-    bool erase(const KeyType& key) override {
+    // erasing O(n) + O(1), O(n) + O(n) if the policy is not NONE (order of elements is kept)
+    bool erase(const KeyType& key) {
         size_t searchRes = linearSearch(key);
-        if (searchRes == size || storage[searchRes].first != key)  // key does not exist
+        if (searchRes == size)  // key does not exist
             return false;
 
         size--;
-        std::swap(storage[searchRes], storage[size]);
+        if (policy == SelfOrganizingPolicy::NONE)
+            swapElements(searchRes, size);
+        else
+            for (size_t i = searchRes; i < size; i++)
+                swapElements(i, i + 1);
 
         return true;
     }
 
-};
+    void clear() {
+        BaseClass::clear();
+        keys.assign(getKeysSize(storage.size()), KeyType());
+        if (policy == SelfOrganizingPolicy::COUNT) counts.assign(storage.size(), 0);
+    }
+
+    // keys and counters of searches are metadata
+    MemoryUsage getMemoryUsage() const {
+        MemoryUsage res = BaseClass::getPackedMemoryUsage();
+        res.addArray(keys.capacity(), size, sizeof(KeyType), 0);
+        res.addArray(counts.capacity(), counts.empty() ? 0 : size, sizeof(size_t), 0);
+        return res;
+    }
 
+    SelfOrganizingPolicy getPolicy() const {
+        return policy;
+    }
+
+    // current order of elements is kept, counters of COUNT policy start from zero
+    void setPolicy(SelfOrganizingPolicy newPolicy) {
+        policy = newPolicy;
+        if (policy == SelfOrganizingPolicy::COUNT)
+            counts.assign(storage.size(), 0);
+        else
+            counts.clear();
+    }
+
+};
@@ -0,0 +1,404 @@
+#pragma once
+#include "PoolAllocator.h"
+
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+
+const size_t CACHE_LINE_SIZE = 64;
+const size_t MIN_CHUNK_CAPACITY_UNROLLED_LIST = 4;
+
+// chunk takes the least number of cache lines that fits MIN_CHUNK_CAPACITY_UNROLLED_LIST elements
+template <class T>
+constexpr size_t getDefaultChunkCapacity() {
+    return ((2 * sizeof(void*) + MIN_CHUNK_CAPACITY_UNROLLED_LIST * sizeof(T) + CACHE_LINE_SIZE - 1)
+        / CACHE_LINE_SIZE * CACHE_LINE_SIZE - 2 * sizeof(void*)) / sizeof(T);
+}
+
+
+// node of unrolled list contains up to Capacity elements stored one by one
+template <class T, size_t Capacity>
+struct UnrolledListChunk {
+    UnrolledListChunk* next = nullptr;
+    size_t count = 0;
+    alignas(T) unsigned char elements[Capacity * sizeof(T)];  // first count elements are constructed
+
+    UnrolledListChunk() {}
+
+    T& operator[](size_t index) {
+        return *reinterpret_cast<T*>(elements + index * sizeof(T));
+    }
+
+    // inserts element to the position, elements after it are shifted
+    template <class U>
+    void insert(size_t index, U&& data) {
+        if (index == count) {
+            new (&(*this)[count]) T(std::forward<U>(data));
+        }
+        else {
+            new (&(*this)[count]) T(std::move((*this)[count - 1]));
+            for (size_t i = count - 1; i > index; i--)
+                (*this)[i] = std::move((*this)[i - 1]);
+            (*this)[index] = std::forward<U>(data);
+        }
+        count++;
+    }
+
+    // erases element from the position, elements after it are shifted
+    void erase(size_t index) {
+        for (size_t i = index + 1; i < count; i++)
+            (*this)[i - 1] = std::move((*this)[i]);
+        count--;
+        (*this)[count].~T();
+    }
+
+    // moves elements [from, count) to the end of other chunk
+    void moveTo(UnrolledListChunk* other, size_t from) {
+        for (size_t i = from; i < count; i++) {
+            new (&(*other)[other->count++]) T(std::move((*this)[i]));
+            (*this)[i].~T();
+        }
+        count = from;
+    }
+};
+
+
+// forward iterator over elements of unrolled list, Value is T or const T
+template <class T, size_t Capacity, class Value = T>
+class UnrolledListIterator {
+    UnrolledListChunk<T, Capacity>* chunk;
+    size_t index;
+
+public:
+
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Value* pointer;
+    typedef Value& reference;
+
+    UnrolledListIterator(UnrolledListChunk<T, Capacity>* chunk = nullptr, size_t index = 0) :
+        chunk(chunk), index(index) {}
+
+    operator UnrolledListIterator<T, Capacity, const T>() const {
+        return UnrolledListIterator<T, Capacity, const T>(chunk, index);
+    }
+
+    UnrolledListChunk<T, Capacity>* getChunk() const {
+        return chunk;
+    }
+
+    size_t getIndex() const {
+        return index;
+    }
+
+    Value& operator*() const {
+        return (*chunk)[index];
+    }
+
+    Value* operator->() const {
+        return &(*chunk)[index];
+    }
+
+    UnrolledListIterator& operator++() {
+        if (++index == chunk->count) {
+            chunk = chunk->next;
+            index = 0;
+        }
+        return *this;
+    }
+
+    UnrolledListIterator operator++(int) {
+        UnrolledListIterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    friend bool operator==(const UnrolledListIterator& it1, const UnrolledListIterator& it2) {
+        return it1.chunk == it2.chunk && it1.index == it2.index;
+    }
+
+    friend bool operator!=(const UnrolledListIterator& it1, const UnrolledListIterator& it2) {
+        return !(it1 == it2);
+    }
+};
+
+
+// singly linked list of chunks with several elements
+// iteration reads elements of a chunk sequentially, so it touches less cache lines than List
+// positions are given by iterators, end() means "before the first element" in insertAfter/eraseAfter
+// insertion and erasing invalidate iterators to elements of the changed chunks
+template <class T, class Allocator = PoolAllocator<T>, size_t ChunkCapacity = getDefaultChunkCapacity<T>()>
+class UnrolledList {
+    static_assert(ChunkCapacity > 0, "Chunk must contain at least one element");
+
+    using Chunk = UnrolledListChunk<T, ChunkCapacity>;
+    using ChunkAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Chunk>;
+    using ChunkAllocatorTraits = std::allocator_traits<ChunkAllocator>;
+
+    Chunk* first = nullptr;
+    Chunk* last = nullptr;
+    size_t size = 0;
+    ChunkAllocator allocator;
+
+    Chunk* createChunk(Chunk* next) {
+        Chunk* chunk = ChunkAllocatorTraits::allocate(allocator, 1);
+        ChunkAllocatorTraits::construct(allocator, chunk);
+        chunk->next = next;
+        return chunk;
+    }
+
+    void destroyChunk(Chunk* chunk) {
+        for (size_t i = 0; i < chunk->count; i++)
+            (*chunk)[i].~T();
+        ChunkAllocatorTraits::destroy(allocator, chunk);
+        ChunkAllocatorTraits::deallocate(allocator, chunk, 1);
+    }
+
+    // erases element, frees chunk if it is empty, merges chunk with the next one if they fit in one
+    // prevChunk is the chunk before chunk or nullptr
+    void eraseFromChunk(Chunk* prevChunk, Chunk* chunk, size_t index) {
+        chunk->erase(index);
+        size--;
+        if (chunk->count == 0) {
+            (prevChunk ? prevChunk->next : first) = chunk->next;
+            if (last == chunk) last = prevChunk;
+            destroyChunk(chunk);
+            return;
+        }
+        Chunk* next = chunk->next;
+        if (next && chunk->count + next->count <= ChunkCapacity) {
+            next->moveTo(chunk, 0);
+            chunk->next = next->next;
+            if (last == next) last = chunk;
+            destroyChunk(next);
+        }
+    }
+
+    template <class U>
+    UnrolledListIterator<T, ChunkCapacity> insertFront(U&& data) {
+        if (!first || first->count == ChunkCapacity) {
+            first = createChunk(first);
+            if (!last) last = first;
+        }
+        first->insert(0, std::forward<U>(data));
+        size++;
+        return UnrolledListIterator<T, ChunkCapacity>(first, 0);
+    }
+
+    void copyToEmptyList(const UnrolledList& list) {
+        for (const T& data : list)
+            pushBack(data);
+    }
+
+public:
+
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef UnrolledListIterator<T, ChunkCapacity> iterator;
+    typedef UnrolledListIterator<T, ChunkCapacity, const T> const_iterator;
+
+    UnrolledList() {}
+
+    explicit UnrolledList(const Allocator& allocator) : allocator(allocator) {}
+
+    UnrolledList(const UnrolledList& list) :
+        allocator(ChunkAllocatorTraits::select_on_container_copy_construction(list.allocator)) {
+        copyToEmptyList(list);
+    }
+
+    // chunks are taken without copying, the allocator is moved together with them
+    UnrolledList(UnrolledList&& list) noexcept :
+        first(list.first), last(list.last), size(list.size), allocator(std::move(list.allocator)) {
+        list.first = list.last = nullptr;
+        list.size = 0;
+    }
+
+    ~UnrolledList() {
+        clear();
+    }
+
+    UnrolledList& operator=(const UnrolledList& list) {
+        if (&list != this) {
+            clear();
+            copyToEmptyList(list);
+        }
+        return *this;
+    }
+
+    friend bool operator==(const UnrolledList& list1, const UnrolledList& list2) {
+        const_iterator it1 = list1.begin(), it2 = list2.begin();
+        for (; it1 != list1.end() && it2 != list2.end(); ++it1, ++it2)
+            if (*it1 != *it2) return false;
+        return it1 == list1.end() && it2 == list2.end();
+    }
+
+    friend bool operator!=(const UnrolledList& list1, const UnrolledList& list2) {
+        return !(list1 == list2);
+    }
+
+    size_t getSize() const {
+        return size;
+    }
+
+    // number of elements which fit into the allocated chunks, O(number of chunks)
+    size_t getCapacity() const {
+        size_t chunks = 0;
+        for (Chunk* chunk = first; chunk; chunk = chunk->next)
+            chunks++;
+        return chunks * ChunkCapacity;
+    }
+
+    // memory allocated for chunks, bytes, O(number of chunks)
+    size_t getAllocatedBytes() const {
+        return getCapacity() / ChunkCapacity * sizeof(Chunk);
+    }
+
+    iterator begin() {
+        return iterator(first, 0);
+    }
+
+    iterator end() {
+        return iterator();
+    }
+
+    const_iterator begin() const {
+        return const_iterator(first, 0);
+    }
+
+    const_iterator end() const {
+        return const_iterator();
+    }
+
+    iterator pushFront(const T& data) {  // returns iterator to new element
+        return insertFront(data);
+    }
+
+    iterator pushFront(T&& data) {  // returns iterator to new element
+        return insertFront(std::move(data));
+    }
+
+    void popFront() {
+        if (empty()) return;
+        eraseFromChunk(nullptr, first, 0);
+    }
+
+    iterator pushBack(const T& data) {  // returns iterator to new element
+        if (!last) return pushFront(data);
+        if (last->count == ChunkCapacity) {
+            last->next = createChunk(nullptr);
+            last = last->next;
+        }
+        last->insert(last->count, data);
+        size++;
+        return iterator(last, last->count - 1);
+    }
+
+    void popBack() {  // O(number of chunks)
+        if (empty()) return;
+        Chunk* prevChunk = nullptr;
+        if (first != last)
+            for (prevChunk = first; prevChunk->next != last; prevChunk = prevChunk->next) {}
+        eraseFromChunk(prevChunk, last, last->count - 1);
+    }
+
+    // returns iterator to new element
+    iterator insertAfter(const T& data, iterator position = iterator()) {
+        Chunk* chunk = position.getChunk();
+        if (!chunk) return pushFront(data);
+        size_t index = position.getIndex() + 1;
+
+        if (chunk->count == ChunkCapacity) {  // split the chunk
+            Chunk* newChunk = createChunk(chunk->next);
+            chunk->next = newChunk;
+            if (last == chunk) last = newChunk;
+            if (index == ChunkCapacity) {  // the element is placed after the full chunk
+                newChunk->insert(0, data);
+                size++;
+                return iterator(newChunk, 0);
+            }
+            chunk->moveTo(newChunk, ChunkCapacity / 2);
+            if (index > chunk->count) {
+                index -= chunk->count;
+                chunk = newChunk;
+            }
+        }
+        chunk->insert(index, data);
+        size++;
+        return iterator(chunk, index);
+    }
+
+    void eraseAfter(iterator position = iterator()) {
+        Chunk* chunk = position.getChunk();
+        if (!chunk) {
+            popFront();
+            return;
+        }
+        if (position.getIndex() + 1 < chunk->count)
+            eraseFromChunk(chunk, chunk, position.getIndex() + 1);  // chunk does not become empty
+        else if (chunk->next)
+            eraseFromChunk(chunk, chunk->next, 0);
+    }
+
+    // moves every element to the front of list getList(element), O(n)
+    // elements are moved, not copied, this list becomes empty
+    template <class GetList>
+    void moveAllTo(GetList getList) {
+        for (Chunk* chunk = first; chunk; chunk = chunk->next)
+            for (size_t i = 0; i < chunk->count; i++)
+                getList((*chunk)[i]).pushFront(std::move((*chunk)[i]));
+        clear();
+    }
+
+    // returns pointer to the first element satisfying predicate or nullptr
+    template <class Predicate>
+    T* findFirst(Predicate predicate) {
+        for (Chunk* chunk = first; chunk; chunk = chunk->next)
+            for (size_t i = 0; i < chunk->count; i++)
+                if (predicate((*chunk)[i])) return &(*chunk)[i];
+        return nullptr;
+    }
+
+    // erases the first element satisfying predicate in one pass
+    // returns true if element was erased
+    template <class Predicate>
+    bool eraseFirst(Predicate predicate) {
+        Chunk* prevChunk = nullptr;
+        for (Chunk* chunk = first; chunk; prevChunk = chunk, chunk = chunk->next)
+            for (size_t i = 0; i < chunk->count; i++)
+                if (predicate((*chunk)[i])) {
+                    eraseFromChunk(prevChunk, chunk, i);
+                    return true;
+                }
+        return false;
+    }
+
+    bool empty() const {
+        return first == nullptr;
+    }
+
+    void clear() {
+        while (first) {
+            Chunk* next = first->next;
+            destroyChunk(first);
+            first = next;
+        }
+        last = nullptr;
+        size = 0;
+        releaseUnusedMemory(allocator);  // whole slabs are freed if the pool is not shared
+    }
+
+    allocator_type getAllocator() const {
+        return allocator_type(allocator);
+    }
+
+    friend std::ostream& operator<<(std::ostream& ostr, const UnrolledList& list) {
+        for (const T& data : list)
+            ostr << data << "; ";
+        ostr << std::endl;
+        return ostr;
+    }
+};
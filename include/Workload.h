@@ -0,0 +1,364 @@
+#pragma once
+#include "Table.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+// generator of reproducible operation streams for tables (YCSB style, B. Cooper et al., 2010)
+// records are numbered in the order of insertion, the key of record r is getRecordKey(r)
+// random numbers are produced by std::mt19937_64 without std distributions,
+// so a seed gives the same stream with all compilers
+
+
+// uniform double from [0, 1), gen produces 32 or 64 random bits (std::mt19937 or std::mt19937_64)
+template <class RandomGenerator>
+double getUniformDouble(RandomGenerator& gen) {
+    if (RandomGenerator::max() == UINT64_MAX)
+        return double(uint64_t(gen()) >> 11) * (1.0 / 9007199254740992.0);  // 53 random bits / 2^53
+    return double(uint32_t(gen())) * (1.0 / 4294967296.0);  // 32 random bits / 2^32
+}
+
+// ranks 0..n-1 with probability of rank i proportional to 1 / (i + 1)^theta
+// (algorithm of Gray et al. used by YCSB)
+class ZipfGenerator {
+    size_t n = 0;
+    double theta, alpha, zetan = 0, eta = 0;
+
+public:
+
+    ZipfGenerator(size_t n, double theta = 0.99) : theta(theta), alpha(1 / (1 - theta)) {
+        resize(n);
+    }
+
+    size_t getSize() const {
+        return n;
+    }
+
+    // the number of ranks can only grow, zeta is extended incrementally
+    void resize(size_t newSize) {
+        for (size_t i = n + 1; i <= newSize; i++)
+            zetan += 1 / std::pow(double(i), theta);
+        n = std::max(n, newSize);
+        double zeta2 = 1 + 1 / std::pow(2.0, theta);
+        eta = (1 - std::pow(2.0 / n, 1 - theta)) / (1 - zeta2 / zetan);
+    }
+
+    template <class RandomGenerator>
+    size_t operator()(RandomGenerator& gen) {
+        double u = getUniformDouble(gen);
+        double uz = u * zetan;
+        if (uz < 1) return 0;
+        if (uz < 1 + std::pow(0.5, theta)) return 1;
+        return std::min(n - 1, size_t(n * std::pow(eta * u - eta + 1, alpha)));
+    }
+};
+
+
+enum class OperationType {
+    READ,               // find
+    UPDATE,             // upsert of existing record
+    INSERT,             // insertion of a new record
+    SCAN,               // search of scanLength consecutive records
+    READ_MODIFY_WRITE,  // update of existing record in one search
+    ERASE,              // erasing of the oldest record
+    COUNT               // number of types
+};
+
+// how records of reads, updates and scans are chosen among existing ones
+enum class KeyChooserType {
+    UNIFORM,
+    ZIPFIAN,     // the oldest records are the most popular
+    LATEST,      // the newest records are the most popular (zipfian from the end)
+    HOTSPOT,     // hotOperationFraction of operations use hotSetFraction of the oldest records
+    SEQUENTIAL   // records in a cycle
+};
+
+struct WorkloadSpec {
+    // proportions of operation types, they are normalized
+    double readProportion = 1;
+    double updateProportion = 0;
+    double insertProportion = 0;
+    double scanProportion = 0;
+    double readModifyWriteProportion = 0;
+    double eraseProportion = 0;
+
+    KeyChooserType keyChooser = KeyChooserType::ZIPFIAN;
+    size_t recordCount = 1000;      // records inserted before the run
+    size_t operationCount = 1000;
+    size_t maxScanLength = 100;     // scan length is uniform from [1, maxScanLength]
+    double zipfianTheta = 0.99;
+    double hotSetFraction = 0.2;
+    double hotOperationFraction = 0.8;
+    uint32_t seed = 1;
+};
+
+struct Operation {
+    OperationType type;
+    uint64_t record;
+    KeyType key;
+    uint32_t scanLength;  // 0 if type is not SCAN
+};
+
+
+// YCSB core workloads A-F, E scans consecutive records because tables have no ordered scans
+inline WorkloadSpec getYcsbWorkload(char name, size_t recordCount = 1000, size_t operationCount = 1000) {
+    WorkloadSpec spec;
+    spec.recordCount = recordCount;
+    spec.operationCount = operationCount;
+    switch (name) {
+    case 'A':  // update heavy
+        spec.readProportion = 0.5;
+        spec.updateProportion = 0.5;
+        break;
+    case 'B':  // read mostly
+        spec.readProportion = 0.95;
+        spec.updateProportion = 0.05;
+        break;
+    case 'C':  // read only
+        break;
+    case 'D':  // read latest
+        spec.readProportion = 0.95;
+        spec.insertProportion = 0.05;
+        spec.keyChooser = KeyChooserType::LATEST;
+        break;
+    case 'E':  // short ranges
+        spec.readProportion = 0;
+        spec.scanProportion = 0.95;
+        spec.insertProportion = 0.05;
+        break;
+    case 'F':  // read-modify-write
+        spec.readProportion = 0.5;
+        spec.readModifyWriteProportion = 0.5;
+        break;
+    default:
+        throw "Unknown YCSB workload";
+    }
+    return spec;
+}
+
+// the table grows from recordCount records, 90% of operations are insertions
+inline WorkloadSpec getInsertRampWorkload(size_t recordCount = 1000, size_t operationCount = 1000) {
+    WorkloadSpec spec;
+    spec.recordCount = recordCount;
+    spec.operationCount = operationCount;
+    spec.readProportion = 0.1;
+    spec.insertProportion = 0.9;
+    spec.keyChooser = KeyChooserType::LATEST;
+    return spec;
+}
+
+// new records replace the oldest ones, so the size of the table stays the same
+inline WorkloadSpec getDeleteChurnWorkload(size_t recordCount = 1000, size_t operationCount = 1000) {
+    WorkloadSpec spec;
+    spec.recordCount = recordCount;
+    spec.operationCount = operationCount;
+    spec.readProportion = 0.5;
+    spec.insertProportion = 0.25;
+    spec.eraseProportion = 0.25;
+    spec.keyChooser = KeyChooserType::UNIFORM;
+    return spec;
+}
+
+
+class WorkloadGenerator {
+    WorkloadSpec spec;
+    std::mt19937_64 gen;
+    ZipfGenerator zipf;
+    double thresholds[size_t(OperationType::COUNT)];  // cumulative proportions
+    uint64_t firstRecord = 0;  // records [firstRecord, endRecord) exist
+    uint64_t endRecord;
+    uint64_t sequentialRecord = 0;
+
+    OperationType chooseType() {
+        double u = getUniformDouble(gen);
+        size_t type = 0;
+        while (type + 1 < size_t(OperationType::COUNT) && u >= thresholds[type]) type++;
+        // operations on records are not generated if the table is empty
+        if (firstRecord == endRecord && OperationType(type) != OperationType::INSERT)
+            return OperationType::INSERT;
+        return OperationType(type);
+    }
+
+    // ranks of erased records are skipped
+    uint64_t chooseZipfRank(uint64_t count) {
+        zipf.resize(size_t(count));
+        uint64_t rank;
+        do rank = zipf(gen); while (rank >= count);
+        return rank;
+    }
+
+    uint64_t chooseRecord() {
+        uint64_t count = endRecord - firstRecord;
+        switch (spec.keyChooser) {
+        case KeyChooserType::UNIFORM:
+            return firstRecord + gen() % count;
+        case KeyChooserType::ZIPFIAN:
+            return firstRecord + chooseZipfRank(count);
+        case KeyChooserType::LATEST:
+            return endRecord - 1 - chooseZipfRank(count);
+        case KeyChooserType::HOTSPOT: {
+            uint64_t hotCount = std::max<uint64_t>(1, uint64_t(spec.hotSetFraction * count));
+            if (getUniformDouble(gen) < spec.hotOperationFraction || hotCount == count)
+                return firstRecord + gen() % hotCount;
+            return firstRecord + hotCount + gen() % (count - hotCount);
+        }
+        default:
+            return firstRecord + sequentialRecord++ % count;
+        }
+    }
+
+public:
+
+    WorkloadGenerator(const WorkloadSpec& spec) :
+        spec(spec), gen(spec.seed), zipf(std::max<size_t>(spec.recordCount, 1), spec.zipfianTheta),
+        endRecord(spec.recordCount) {
+        double proportions[] = { spec.readProportion, spec.updateProportion, spec.insertProportion,
+            spec.scanProportion, spec.readModifyWriteProportion, spec.eraseProportion };
+        double sum = 0;
+        for (double proportion : proportions) {
+            if (proportion < 0) throw "Proportions of operations must be non-negative";
+            sum += proportion;
+        }
+        if (sum == 0) throw "Workload contains no operations";
+        double cumulative = 0;
+        for (size_t i = 0; i < size_t(OperationType::COUNT); i++) {
+            cumulative += proportions[i] / sum;
+            thresholds[i] = cumulative;
+        }
+    }
+
+    // keys are distinct for 2^32 records (multiplication by an odd number is a bijection)
+    static KeyType getRecordKey(uint64_t record) {
+        return KeyType(uint32_t(record) * 2654435761u);
+    }
+
+    const WorkloadSpec& getSpec() const {
+        return spec;
+    }
+
+    // keys of records inserted before the run
+    std::vector<KeyType> getLoadKeys() const {
+        std::vector<KeyType> keys(spec.recordCount);
+        for (size_t i = 0; i < spec.recordCount; i++)
+            keys[i] = getRecordKey(i);
+        return keys;
+    }
+
+    // the number of existing records after the generated operations
+    size_t getRecordCount() const {
+        return size_t(endRecord - firstRecord);
+    }
+
+    Operation next() {
+        Operation operation;
+        operation.type = chooseType();
+        operation.scanLength = 0;
+        switch (operation.type) {
+        case OperationType::INSERT:
+            operation.record = endRecord++;
+            break;
+        case OperationType::ERASE:
+            operation.record = firstRecord++;
+            break;
+        case OperationType::SCAN:
+            operation.record = chooseRecord();
+            operation.scanLength = uint32_t(1 + gen() % std::max<size_t>(spec.maxScanLength, 1));
+            operation.scanLength = uint32_t(std::min<uint64_t>(operation.scanLength, endRecord - operation.record));
+            break;
+        default:
+            operation.record = chooseRecord();
+        }
+        operation.key = getRecordKey(operation.record);
+        return operation;
+    }
+
+    // spec.operationCount next operations
+    std::vector<Operation> generate() {
+        std::vector<Operation> operations(spec.operationCount);
+        for (Operation& operation : operations)
+            operation = next();
+        return operations;
+    }
+};
+
+
+struct WorkloadResult {
+    double totalNs = 0;
+    size_t succeeded = 0;  // operations which found their records or inserted new ones
+    std::vector<double> latenciesNs;  // latencies of operations in the same order, if they were recorded
+
+    // latencies of operations of the type
+    std::vector<double> getLatencies(const std::vector<Operation>& operations, OperationType type) const {
+        std::vector<double> latencies;
+        for (size_t i = 0; i < latenciesNs.size(); i++)
+            if (operations[i].type == type) latencies.push_back(latenciesNs[i]);
+        return latencies;
+    }
+};
+
+
+// inserts records of the workload before the run
+template <class TableType>
+void loadWorkload(TableType& table, const WorkloadGenerator& generator,
+    const typename TableType::elem_type& elem = typename TableType::elem_type()) {
+    for (KeyType key : generator.getLoadKeys())
+        table.insert(key, elem);
+}
+
+// returns true if the operation found its records or inserted a new one
+template <class TableType>
+bool runOperation(TableType& table, const Operation& operation, const typename TableType::elem_type& elem) {
+    typedef typename TableType::elem_type ElemType;
+    switch (operation.type) {
+    case OperationType::READ:
+        return table.find(operation.key) != nullptr;
+    case OperationType::UPDATE:
+        return !table.upsert(operation.key, elem);
+    case OperationType::INSERT:
+        return table.insert(operation.key, elem);
+    case OperationType::SCAN: {
+        size_t found = 0;
+        for (uint32_t i = 0; i < operation.scanLength; i++)
+            found += table.find(WorkloadGenerator::getRecordKey(operation.record + i)) != nullptr;
+        return found == operation.scanLength;
+    }
+    case OperationType::READ_MODIFY_WRITE:
+        return !table.update(operation.key, [&elem](ElemType& oldElem) { oldElem = elem; });
+    case OperationType::ERASE:
+        return table.erase(operation.key);
+    default:
+        return false;
+    }
+}
+
+// runs operations on a table type or on TableInterface
+// latency of every operation is recorded if recordLatencies is true, it adds the overhead of the clock
+template <class TableType>
+WorkloadResult runWorkload(TableType& table, const std::vector<Operation>& operations, bool recordLatencies = true,
+    const typename TableType::elem_type& elem = typename TableType::elem_type()) {
+    typedef std::chrono::steady_clock Clock;
+    WorkloadResult result;
+    if (recordLatencies) result.latenciesNs.resize(operations.size());
+
+    Clock::time_point start = Clock::now();
+    if (recordLatencies) {
+        Clock::time_point operationStart = start;
+        for (size_t i = 0; i < operations.size(); i++) {
+            result.succeeded += runOperation(table, operations[i], elem);
+            Clock::time_point operationEnd = Clock::now();
+            result.latenciesNs[i] = std::chrono::duration<double, std::nano>(operationEnd - operationStart).count();
+            operationStart = operationEnd;
+        }
+    }
+    else {
+        for (const Operation& operation : operations)
+            result.succeeded += runOperation(table, operation, elem);
+    }
+    result.totalNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return result;
+}
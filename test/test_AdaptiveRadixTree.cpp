@@ -0,0 +1,112 @@
+#include "AdaptiveRadixTree.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest.h>
+
+
+class TestAdaptiveRadixTree : public testing::Test {
+public:
+
+    AdaptiveRadixTree<int> tree;
+
+    std::vector<KeyType> getKeys(AdaptiveRadixTree<int>& t) {
+        std::vector<KeyType> keys;
+        t.forEach([&keys](std::pair<KeyType, int>& elem) { keys.push_back(elem.first); });
+        return keys;
+    }
+};
+
+
+TEST_F(TestAdaptiveRadixTree, can_find_keys_with_common_prefix) {
+    tree.insert(0x12345678, 1);
+    tree.insert(0x12345679, 2);
+    tree.insert(0x12340000, 3);
+
+    EXPECT_EQ(1, tree.find(0x12345678)->second);
+    EXPECT_EQ(2, tree.find(0x12345679)->second);
+    EXPECT_EQ(3, tree.find(0x12340000)->second);
+    EXPECT_EQ(nullptr, tree.find(0x12345600));
+    EXPECT_EQ(nullptr, tree.find(0x22345678));
+}
+
+TEST_F(TestAdaptiveRadixTree, can_grow_nodes_up_to_256_children) {
+    for (KeyType key = 0; key < 256; key++)
+        tree.insert(key << 8, int(key));
+
+    for (KeyType key = 0; key < 256; key++)
+        ASSERT_EQ(int(key), tree.find(key << 8)->second);
+    EXPECT_EQ(256, tree.getSize());
+}
+
+TEST_F(TestAdaptiveRadixTree, can_shrink_nodes_when_erasing) {
+    for (KeyType key = 0; key < 256; key++)
+        tree.insert(key << 8, int(key));
+
+    for (KeyType key = 0; key < 255; key++)
+        ASSERT_TRUE(tree.erase(key << 8));
+
+    EXPECT_EQ(1, tree.getSize());
+    EXPECT_EQ(255, tree.find(255 << 8)->second);
+    EXPECT_EQ(nullptr, tree.find(0));
+}
+
+TEST_F(TestAdaptiveRadixTree, erasing_restores_path_compression) {
+    tree.insert(0x11223344, 1);
+    tree.insert(0x11223355, 2);
+    tree.insert(0x11aa0000, 3);
+
+    tree.erase(0x11aa0000);
+    tree.insert(0x11223366, 4);
+
+    EXPECT_EQ(1, tree.find(0x11223344)->second);
+    EXPECT_EQ(2, tree.find(0x11223355)->second);
+    EXPECT_EQ(4, tree.find(0x11223366)->second);
+    EXPECT_EQ(nullptr, tree.find(0x11aa0000));
+}
+
+TEST_F(TestAdaptiveRadixTree, iterates_in_ascending_order_of_keys) {
+    std::vector<KeyType> keys;
+    std::mt19937 gen(1);
+    for (int i = 0; i < 1000; i++) {
+        KeyType key = gen() % 100000;
+        if (tree.insert(key, i)) keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    EXPECT_EQ(keys, getKeys(tree));
+}
+
+TEST_F(TestAdaptiveRadixTree, range_scan_visits_only_keys_in_range) {
+    for (KeyType key = 0; key < 1000; key += 10)
+        tree.insert(key, int(key));
+
+    std::vector<KeyType> keys;
+    tree.forEachInRange(95, 140, [&keys](std::pair<KeyType, int>& elem) { keys.push_back(elem.first); });
+
+    EXPECT_EQ(std::vector<KeyType>({ 100, 110, 120, 130, 140 }), keys);
+}
+
+TEST_F(TestAdaptiveRadixTree, range_scan_can_include_max_key) {
+    tree.insert(KeyType(-1), 1);
+    tree.insert(0, 2);
+
+    std::vector<KeyType> keys;
+    tree.forEachInRange(1, KeyType(-1), [&keys](std::pair<KeyType, int>& elem) { keys.push_back(elem.first); });
+
+    EXPECT_EQ(std::vector<KeyType>({ KeyType(-1) }), keys);
+}
+
+TEST_F(TestAdaptiveRadixTree, can_copy_tree) {
+    for (KeyType key = 0; key < 100; key++)
+        tree.insert(key * 1000, int(key));
+
+    AdaptiveRadixTree<int> tree2(tree);
+    tree.erase(0);
+    tree.find(1000)->second = -1;
+
+    EXPECT_EQ(100, tree2.getSize());
+    EXPECT_EQ(0, tree2.find(0)->second);
+    EXPECT_EQ(1, tree2.find(1000)->second);
+}
@@ -0,0 +1,75 @@
+#include "DirectAddressTable.h"
+
+#include <vector>
+
+#include <gtest.h>
+
+
+class TestDirectAddressTable : public testing::Test {
+public:
+
+    DirectAddressTable<int> table;
+
+    std::vector<KeyType> getKeys() {
+        std::vector<KeyType> keys;
+        table.forEach([&keys](std::pair<KeyType, int>& elem) { keys.push_back(elem.first); });
+        return keys;
+    }
+};
+
+
+TEST_F(TestDirectAddressTable, can_insert_keys_greater_than_window) {
+    for (KeyType key = 0; key < 1000; key += 7)
+        table.insert(key, int(key));
+
+    for (KeyType key = 0; key < 1000; key += 7)
+        ASSERT_EQ(int(key), table.find(key)->second);
+    EXPECT_EQ(nullptr, table.find(1));
+}
+
+TEST_F(TestDirectAddressTable, can_insert_keys_less_than_window) {
+    table.insert(1000000, 1);
+    table.insert(999000, 2);
+    table.insert(5, 3);
+
+    EXPECT_EQ(1, table.find(1000000)->second);
+    EXPECT_EQ(2, table.find(999000)->second);
+    EXPECT_EQ(3, table.find(5)->second);
+    EXPECT_EQ(3, table.getSize());
+}
+
+TEST_F(TestDirectAddressTable, can_insert_max_key) {
+    table.insert(KeyType(-1), 1);
+    table.insert(KeyType(-100), 2);
+
+    EXPECT_EQ(1, table.find(KeyType(-1))->second);
+    EXPECT_EQ(2, table.find(KeyType(-100))->second);
+}
+
+TEST_F(TestDirectAddressTable, throws_if_key_range_is_too_wide) {
+    table.insert(0, 1);
+
+    EXPECT_ANY_THROW(table.insert(KeyType(-1), 2));
+    EXPECT_EQ(1, table.find(0)->second);
+}
+
+TEST_F(TestDirectAddressTable, iterates_in_ascending_order_of_keys) {
+    table.insert(300, 1);
+    table.insert(7, 2);
+    table.insert(64, 3);
+    table.insert(63, 4);
+    table.erase(64);
+
+    EXPECT_EQ(std::vector<KeyType>({ 7, 63, 300 }), getKeys());
+}
+
+TEST_F(TestDirectAddressTable, can_count_elements_in_range) {
+    for (KeyType key = 100; key < 1100; key += 2)
+        table.insert(key, int(key));
+
+    EXPECT_EQ(500, table.countInRange(0, 5000));
+    EXPECT_EQ(33, table.countInRange(135, 200));
+    EXPECT_EQ(1, table.countInRange(100, 100));
+    EXPECT_EQ(0, table.countInRange(101, 101));
+    EXPECT_EQ(0, table.countInRange(2000, 3000));
+}
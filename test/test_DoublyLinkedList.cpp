@@ -0,0 +1,118 @@
+#include "DoublyLinkedList.h"
+
+#include <vector>
+
+#include <gtest.h>
+
+
+class TestDoublyLinkedList : public testing::Test {
+public:
+
+    DoublyLinkedList<int> list;
+
+    TestDoublyLinkedList() {
+        list.pushBack(1);
+        list.pushBack(2);
+        list.pushBack(3);
+    }
+
+    // checks links in both directions
+    std::vector<int> toVector(const DoublyLinkedList<int>& l) {
+        std::vector<int> forward(l.begin(), l.end()), backward;
+        for (auto ptr = l.getLast(); ptr; ptr = ptr->prev)
+            backward.insert(backward.begin(), ptr->data);
+        EXPECT_EQ(forward, backward);
+        EXPECT_EQ(forward.size(), l.getSize());
+        return forward;
+    }
+};
+
+
+TEST_F(TestDoublyLinkedList, can_push_front_and_back) {
+    list.pushFront(0);
+    list.pushBack(4);
+
+    EXPECT_EQ(std::vector<int>({ 0, 1, 2, 3, 4 }), toVector(list));
+}
+
+TEST_F(TestDoublyLinkedList, can_pop_front_and_back) {
+    list.popBack();
+    list.popFront();
+
+    EXPECT_EQ(std::vector<int>({ 2 }), toVector(list));
+    list.popBack();
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(nullptr, list.getLast());
+}
+
+TEST_F(TestDoublyLinkedList, can_be_used_as_queue) {
+    DoublyLinkedList<int> queue;
+    for (int i = 0; i < 100; i++) {
+        queue.pushBack(i);
+        if (i % 2) queue.popFront();
+    }
+
+    EXPECT_EQ(50, queue.getSize());
+    EXPECT_EQ(50, queue.getFirst()->data);
+    EXPECT_EQ(99, queue.getLast()->data);
+}
+
+TEST_F(TestDoublyLinkedList, can_insert_after_and_erase) {
+    list.insertAfter(10, list.getFirst());
+    list.erase(list.getLast());
+    list.eraseAfter();
+
+    EXPECT_EQ(std::vector<int>({ 10, 2 }), toVector(list));
+}
+
+TEST_F(TestDoublyLinkedList, can_iterate_backward) {
+    auto it = list.begin();
+    ++it;
+    ++it;
+    --it;
+
+    EXPECT_EQ(2, *it);
+}
+
+TEST_F(TestDoublyLinkedList, can_erase_first_by_predicate) {
+    EXPECT_TRUE(list.eraseFirst([](int x) { return x == 2; }));
+    EXPECT_FALSE(list.eraseFirst([](int x) { return x == 2; }));
+
+    EXPECT_EQ(std::vector<int>({ 1, 3 }), toVector(list));
+}
+
+TEST_F(TestDoublyLinkedList, can_copy_and_move_list) {
+    DoublyLinkedList<int> list2(list);
+    EXPECT_EQ(list, list2);
+
+    auto first = list.getFirst();
+    DoublyLinkedList<int> list3(std::move(list));
+    EXPECT_EQ(first, list3.getFirst());
+    EXPECT_TRUE(list.empty());
+
+    list2.popBack();
+    list3 = std::move(list2);
+    EXPECT_EQ(std::vector<int>({ 1, 2 }), toVector(list3));
+}
+
+TEST_F(TestDoublyLinkedList, can_splice_whole_list_and_range) {
+    DoublyLinkedList<int> list2(list.getAllocator());
+    list2.pushBack(10);
+    list2.pushBack(20);
+    list2.pushBack(30);
+
+    list.spliceAfter(list.getFirst(), list2, list2.getFirst()->next, list2.getLast(), 2);
+    EXPECT_EQ(std::vector<int>({ 1, 20, 30, 2, 3 }), toVector(list));
+    EXPECT_EQ(std::vector<int>({ 10 }), toVector(list2));
+
+    list.spliceAfter(list.getLast(), list2);
+    EXPECT_EQ(std::vector<int>({ 1, 20, 30, 2, 3, 10 }), toVector(list));
+    EXPECT_TRUE(list2.empty());
+}
+
+TEST_F(TestDoublyLinkedList, throws_when_splice_lists_with_different_allocators) {
+    DoublyLinkedList<int> list2;
+    list2.pushBack(10);
+
+    EXPECT_ANY_THROW(list.spliceAfter(nullptr, list2));
+}
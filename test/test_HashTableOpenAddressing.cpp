@@ -1,6 +1,9 @@
 #include "HashTableOpenAddressing.h"
 #include "HashTableSeparateChaining.h"
 
+#include <algorithm>
+#include <random>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -104,6 +107,25 @@ TEST_F(TestHashTableSeparateChaining, repack_dont_break_table) {
     ASSERT_FALSE(table->isEmpty());
 }
 
+TEST_F(TestHashTableSeparateChaining, repack_keeps_elements_in_place) {
+    std::vector<std::pair<KeyType, std::string>*> elements;
+    for (int i = 0; i < 5; i++) {
+        table->insert(notCollisionKeys[i], values[i]);
+        elements.push_back(table->find(notCollisionKeys[i]));
+    }
+    size_t storageSize = storage.size();
+
+    table->insert(notCollisionKeys[5], values[5]);  // repack is called
+
+    ASSERT_GT(storage.size(), storageSize);
+    size_t count = 0;
+    for (auto& bucket : storage)
+        count += bucket.getSize();
+    EXPECT_EQ(6, count);
+    for (int i = 0; i < 5; i++)
+        EXPECT_EQ(elements[i], table->find(notCollisionKeys[i]));
+}
+
 
 typedef TestHashTable<HashTableOpenAddressing<std::string>> TestHashTableOpenAddressing;
 
@@ -186,3 +208,376 @@ TEST_F(TestHashTableOpenAddressing, can_repack_table_if_insert_is_called_and_emp
 
     ASSERT_GT(storage.size(), size);
 }
+
+TEST_F(TestHashTableOpenAddressing, repack_drops_deleted_elements) {
+    for (int i = 0; i < 5; i++)
+        table->insert(notCollisionKeys[i], values[i]);
+    table->erase(notCollisionKeys[0]);
+    table->erase(notCollisionKeys[1]);
+
+    for (int i = 0; i < 4; i++)
+        table->insert(notCollisionKeys[5] + i + 1, values[i]);  // repack is called
+
+    ASSERT_EQ(7, table->getSize());
+    ASSERT_EQ(nullptr, table->find(notCollisionKeys[0]));
+    ASSERT_EQ(nullptr, table->find(notCollisionKeys[1]));
+    size_t count = 0;
+    for (auto& cell : storage)
+        count += !cell.is_cell_empty;
+    ASSERT_EQ(7, count);
+}
+
+
+typedef TestHashTable<HashTableOpenAddressing<std::string, HashedPair<std::string>>> TestHashTableCachedHashOpenAddressing;
+
+TEST_F(TestHashTableCachedHashOpenAddressing, cell_keeps_hash_of_key) {
+    for (int i = 0; i < 3; i++)
+        table->insert(notCollisionKeys[i], values[i]);
+
+    for (int i = 0; i < 3; i++)
+        ASSERT_EQ(fullHash(notCollisionKeys[i]), static_cast<HashedPair<std::string>*>(table->find(notCollisionKeys[i]))->hash);
+}
+
+TEST_F(TestHashTableCachedHashOpenAddressing, can_find_elements_if_collision_after_repack) {
+    for (int i = 0; i < 3; i++)
+        table->insert(collisionKeys[i], values[i]);
+
+    table->insert(collisionKeys[3], values[3]);  // repack is called
+
+    for (int i = 0; i < 4; i++)
+        ASSERT_EQ(values[i], table->find(collisionKeys[i])->second);
+    ASSERT_EQ(nullptr, table->find(collisionKeys[4]));
+}
+
+TEST_F(TestHashTableCachedHashOpenAddressing, hash_is_compared_before_key) {
+    table->insert(notCollisionKeys[0], values[0]);
+    static_cast<HashedPair<std::string>*>(table->find(notCollisionKeys[0]))->hash++;
+
+    ASSERT_EQ(nullptr, table->find(notCollisionKeys[0]));
+}
+
+
+typedef TestHashTable<HashTableSeparateChaining<std::string, List<HashedPair<std::string>>>> TestHashTableCachedHashChaining;
+
+TEST_F(TestHashTableCachedHashChaining, cell_keeps_hash_of_key) {
+    for (int i = 0; i < 3; i++)
+        table->insert(collisionKeys[i], values[i]);
+
+    for (int i = 0; i < 3; i++)
+        ASSERT_EQ(fullHash(collisionKeys[i]), static_cast<HashedPair<std::string>*>(table->find(collisionKeys[i]))->hash);
+}
+
+TEST_F(TestHashTableCachedHashChaining, repack_uses_cached_hash) {
+    for (int i = 0; i < 5; i++)
+        table->insert(notCollisionKeys[i], values[i]);
+
+    a = 3;  // hashes of keys are not recomputed with the new parameter
+    repack();
+    a = 1;
+
+    for (int i = 0; i < 5; i++)
+        ASSERT_EQ(values[i], table->find(notCollisionKeys[i])->second);
+    ASSERT_EQ(5, table->getSize());
+}
+
+
+typedef TestHashTable<HashTableOpenAddressing<std::string, std::pair<KeyType, std::string>,
+    HashTableStatisticsCollector>> TestHashTableOpenAddressingStatistics;
+
+TEST_F(TestHashTableOpenAddressingStatistics, counts_probe_lengths_of_hits_and_misses) {
+    for (int i = 0; i < 3; i++)
+        table->insert(collisionKeys[i], values[i]);
+    resetStatistics();
+
+    table->find(collisionKeys[2]);
+    table->find(collisionKeys[3]);
+
+    HashTableStatistics statistics = table->getStatistics();
+    EXPECT_TRUE(statistics.collected);
+    EXPECT_EQ(1, statistics.hitProbeLengths[3]);
+    EXPECT_EQ(1, statistics.missProbeLengths[storage.size()]);  // quadratic probing visits only cells 0, 1 and 4
+}
+
+TEST_F(TestHashTableOpenAddressingStatistics, counts_tombstones_and_repacks) {
+    for (int i = 0; i < 3; i++)
+        table->insert(notCollisionKeys[i], values[i]);
+    table->erase(notCollisionKeys[0]);
+
+    EXPECT_EQ(1, table->getStatistics().tombstones);
+    EXPECT_EQ(0, table->getStatistics().repackCount);
+
+    for (int i = 3; i < 6; i++)
+        table->insert(notCollisionKeys[i], values[i]);
+    table->insert(notCollisionKeys[0], values[0]);  // repack is called
+
+    HashTableStatistics statistics = table->getStatistics();
+    EXPECT_EQ(1, statistics.repackCount);
+    EXPECT_EQ(0, statistics.tombstones);
+    EXPECT_EQ(6, statistics.size);
+    EXPECT_EQ(storage.size(), statistics.storageSize);
+    EXPECT_DOUBLE_EQ(6.0 / storage.size(), statistics.loadFactor);
+}
+
+TEST_F(TestHashTableOpenAddressing, statistics_are_not_collected_by_default) {
+    for (int i = 0; i < 3; i++)
+        table->insert(collisionKeys[i], values[i]);
+    table->find(collisionKeys[2]);
+
+    HashTableStatistics statistics = table->getStatistics();
+    EXPECT_FALSE(statistics.collected);
+    EXPECT_EQ(0, statistics.hitProbeLengths[3]);
+    EXPECT_EQ(3, statistics.size);
+}
+
+// statistics policy of one word, it shows the memory of the policy in the table
+struct OneWordHashTableStatistics : NoHashTableStatistics {
+    size_t counter = 0;
+};
+
+TEST(TestHashTableStatistics, disabled_statistics_take_no_memory) {
+    EXPECT_EQ(sizeof(HashTableOpenAddressing<int>) + sizeof(size_t),
+        sizeof(HashTableOpenAddressing<int, std::pair<KeyType, int>, OneWordHashTableStatistics>));
+    EXPECT_EQ(sizeof(HashTableSeparateChaining<int>) + sizeof(size_t),
+        sizeof(HashTableSeparateChaining<int, List<std::pair<KeyType, int>>, OneWordHashTableStatistics>));
+}
+
+
+typedef TestHashTable<HashTableSeparateChaining<std::string, List<std::pair<KeyType, std::string>>,
+    HashTableStatisticsCollector>> TestHashTableSeparateChainingStatistics;
+
+TEST_F(TestHashTableSeparateChainingStatistics, counts_chain_lengths) {
+    for (int i = 0; i < 3; i++)
+        table->insert(collisionKeys[i], values[i]);
+
+    HashTableStatistics statistics = table->getStatistics();
+    EXPECT_EQ(1, statistics.chainLengths[3]);
+    EXPECT_EQ(storage.size() - 1, statistics.chainLengths[0]);
+}
+
+TEST_F(TestHashTableSeparateChainingStatistics, counts_searches_in_chains) {
+    for (int i = 0; i < 3; i++)
+        table->insert(collisionKeys[i], values[i]);
+    resetStatistics();
+
+    table->find(collisionKeys[0]);  // the first inserted element is the last in the chain
+    table->find(collisionKeys[3]);
+    table->erase(collisionKeys[2]);
+
+    HashTableStatistics statistics = table->getStatistics();
+    EXPECT_EQ(1, statistics.hitProbeLengths[3]);
+    EXPECT_EQ(1, statistics.hitProbeLengths[1]);
+    EXPECT_EQ(1, statistics.missProbeLengths[3]);
+}
+
+TEST_F(TestHashTableSeparateChainingStatistics, can_print_statistics) {
+    for (int i = 0; i < 6; i++)
+        table->insert(notCollisionKeys[i], values[i]);  // repack is called
+
+    std::ostringstream ostr;
+    ostr << table->getStatistics();
+
+    EXPECT_NE(std::string::npos, ostr.str().find("repacks: 1"));
+    EXPECT_NE(std::string::npos, ostr.str().find("chain lengths"));
+}
+
+
+TEST_F(TestHashTableOpenAddressing, deleted_cells_cause_rehash_without_growth) {
+    for (int i = 0; i < 3; i++)
+        table->insert(notCollisionKeys[i], values[i]);
+    table->erase(notCollisionKeys[0]);
+    table->erase(notCollisionKeys[1]);  // a quarter of cells is deleted
+
+    table->insert(notCollisionKeys[3], values[3]);  // rehash is called
+
+    ASSERT_EQ(8, storage.size());
+    for (auto& cell : storage)
+        ASSERT_FALSE(cell.is_element_was_deleted);
+    ASSERT_EQ(values[2], table->find(notCollisionKeys[2])->second);
+    ASSERT_EQ(values[3], table->find(notCollisionKeys[3])->second);
+}
+
+TEST_F(TestHashTableOpenAddressing, deleted_cells_are_kept_if_policy_allows) {
+    HashTablePolicy policy;
+    policy.maxTombstoneFactor = 1;
+    setHashTablePolicy(policy);
+    for (int i = 0; i < 3; i++)
+        table->insert(notCollisionKeys[i], values[i]);
+    table->erase(notCollisionKeys[0]);
+    table->erase(notCollisionKeys[1]);
+
+    table->insert(notCollisionKeys[3], values[3]);
+
+    size_t count = 0;
+    for (auto& cell : storage)
+        count += cell.is_element_was_deleted;
+    ASSERT_EQ(2, count);
+}
+
+
+template <class TableType>
+size_t getStorageSizeAfterInsertions(const HashTablePolicy& policy, size_t n) {
+    TableType table(policy);
+    for (KeyType key = 0; key < n; key++)
+        table.insert(key, int(key));
+    for (KeyType key = 0; key < n; key++)
+        EXPECT_EQ(int(key), table.find(key)->second);
+    return table.getStatistics().storageSize;
+}
+
+// quadratic probing of a tiny table visits few cells and can repack it before the threshold,
+// so the table is large enough
+TEST(TestHashTablePolicy, max_load_factor_sets_repack_threshold) {
+    HashTablePolicy policy;
+    policy.startStorageSizeDeg = 10;
+    policy.maxLoadFactor = 0.5;
+
+    EXPECT_EQ(1024, getStorageSizeAfterInsertions<HashTableOpenAddressing<int>>(policy, 512));
+    EXPECT_EQ(2048, getStorageSizeAfterInsertions<HashTableOpenAddressing<int>>(policy, 513));
+}
+
+TEST(TestHashTablePolicy, separate_chaining_can_be_loaded_more_than_once) {
+    HashTablePolicy policy;
+    policy.startStorageSizeDeg = 2;
+    policy.maxLoadFactor = 4;
+
+    EXPECT_EQ(4, getStorageSizeAfterInsertions<HashTableSeparateChaining<int>>(policy, 16));
+    EXPECT_EQ(8, getStorageSizeAfterInsertions<HashTableSeparateChaining<int>>(policy, 17));
+}
+
+TEST(TestHashTablePolicy, growth_degree_sets_growth_factor) {
+    HashTablePolicy policy;
+    policy.growthDeg = 2;
+
+    EXPECT_EQ(64, getStorageSizeAfterInsertions<HashTableOpenAddressing<int>>(policy, 12));
+    EXPECT_EQ(64, getStorageSizeAfterInsertions<HashTableSeparateChaining<int>>(policy, 12));
+}
+
+TEST(TestHashTablePolicy, start_capacity_is_inserted_without_repack) {
+    HashTablePolicy policy;
+    policy.setStartCapacity(1000);
+    HashTableOpenAddressing<int, std::pair<KeyType, int>, HashTableStatisticsCollector> table(policy);
+    for (KeyType key = 0; key < 1000; key++)
+        table.insert(key, int(key));
+    table.insert(1000, 0);
+
+    // a rare reseed rehashes the table without growth
+    HashTableStatistics statistics = table.getStatistics();
+    EXPECT_EQ(statistics.reseedCount, statistics.repackCount);
+    EXPECT_EQ(2048, statistics.storageSize);
+}
+
+TEST(TestHashTablePolicy, clear_returns_to_start_storage_size) {
+    HashTablePolicy policy;
+    policy.startStorageSizeDeg = 6;
+    HashTableSeparateChaining<int> table(policy);
+    for (KeyType key = 0; key < 100; key++)
+        table.insert(key, int(key));
+
+    table.clear();
+
+    EXPECT_EQ(64, table.getStatistics().storageSize);
+}
+
+TEST(TestHashTablePolicy, throws_if_policy_is_invalid) {
+    HashTablePolicy policy;
+    policy.growthDeg = 0;
+    EXPECT_ANY_THROW(HashTableOpenAddressing<int> table(policy));
+
+    HashTableSeparateChaining<int> table;
+    policy = HashTablePolicy();
+    policy.maxLoadFactor = 0;
+    EXPECT_ANY_THROW(table.setHashTablePolicy(policy));
+    policy = HashTablePolicy();
+    policy.maxTombstoneFactor = 1.5;
+    EXPECT_ANY_THROW(table.setHashTablePolicy(policy));
+}
+
+
+// random keys less than 2^20 and the hash parameter 1, so all keys are in the first cell before reseed
+// while the storage size is not greater than 2^12 (keys 0, 1, 2, ... would collide too,
+// but they are clustered again by about 1 of 1000 new parameters)
+template <class TableType>
+std::vector<KeyType> insertFloodingKeys(TableType* table, size_t n) {
+    std::mt19937 gen(6);
+    std::vector<KeyType> keys;
+    while (keys.size() < n) {
+        KeyType key = KeyType(gen()) & ((KeyType(1) << 20) - 1);
+        if (table->insert(key, std::to_string(key))) keys.push_back(key);
+    }
+    return keys;
+}
+
+// the hash parameters after reseeds are taken from the seeded generator, so the test doesn't depend on them;
+// the new parameter spreads the keys, so probes are short for all of them and reseeds don't repeat
+TEST_F(TestHashTableOpenAddressingStatistics, colliding_keys_cause_reseed) {
+    getHashParameterGenerator().seed(7);
+    std::vector<KeyType> keys = insertFloodingKeys(table, 1000);
+
+    size_t maxProbeLength = 0, longProbes = 0;
+    for (KeyType key : keys) {
+        size_t i = 0;
+        while (storage[getProbeSequenceElem(hash(key), i)].data.first != key)
+            i++;
+        maxProbeLength = std::max(maxProbeLength, i + 1);
+        longProbes += i + 1 > 16;
+    }
+    HashTableStatistics statistics = table->getStatistics();
+    EXPECT_LE(1, statistics.reseedCount);
+    EXPECT_GE(2, statistics.reseedCount);
+    EXPECT_GE(HashTablePolicy().maxProbeLength, maxProbeLength);
+    EXPECT_GE(keys.size() / 100, longProbes);
+    for (KeyType key : keys)
+        ASSERT_EQ(std::to_string(key), table->find(key)->second);
+}
+
+TEST_F(TestHashTableSeparateChainingStatistics, colliding_keys_cause_reseed) {
+    getHashParameterGenerator().seed(7);
+    std::vector<KeyType> keys = insertFloodingKeys(table, 1000);
+
+    size_t maxChainLength = 0;
+    for (auto& bucket : storage)
+        maxChainLength = std::max(maxChainLength, bucket.getSize());
+    HashTableStatistics statistics = table->getStatistics();
+    EXPECT_LE(1, statistics.reseedCount);
+    EXPECT_GE(2, statistics.reseedCount);
+    EXPECT_GE(size_t(16), maxChainLength);
+    for (KeyType key : keys)
+        ASSERT_EQ(std::to_string(key), table->find(key)->second);
+}
+
+TEST_F(TestHashTableCachedHashOpenAddressing, reseed_recomputes_cached_hashes) {
+    for (KeyType key : insertFloodingKeys(table, 1000))
+        ASSERT_EQ(fullHash(key), static_cast<HashedPair<std::string>*>(table->find(key))->hash);
+}
+
+TEST_F(TestHashTableCachedHashChaining, reseed_recomputes_cached_hashes) {
+    for (KeyType key : insertFloodingKeys(table, 1000))
+        ASSERT_EQ(fullHash(key), static_cast<HashedPair<std::string>*>(table->find(key))->hash);
+}
+
+// quadratic probing of a small table visits few cells, so even random keys rarely fill all of them
+// and cause a reseed (about 1 table of 1000), several reseeds would mean false detection of flooding
+TEST(TestHashTablePolicy, usual_keys_rarely_cause_reseed) {
+    std::mt19937 gen(5);
+    size_t reseeds = 0;
+    for (int t = 0; t < 10; t++) {
+        HashTableOpenAddressing<int, std::pair<KeyType, int>, HashTableStatisticsCollector> table;
+        for (int i = 0; i < 10000; i++)
+            table.insert(KeyType(gen()), i);
+        reseeds += table.getStatistics().reseedCount;
+    }
+
+    EXPECT_GE(2, reseeds);
+}
+
+TEST(TestHashTablePolicy, reseeds_take_amortized_constant_time) {
+    HashTablePolicy policy;
+    policy.maxProbeLength = 1;  // almost every insertion wants reseed
+    HashTableSeparateChaining<int, List<std::pair<KeyType, int>>, HashTableStatisticsCollector> table(policy);
+    for (KeyType key = 0; key < 1000; key++)
+        table.insert(key, int(key));
+
+    EXPECT_GE(12, table.getStatistics().reseedCount);  // the size is doubled between reseeds
+    for (KeyType key = 0; key < 1000; key++)
+        ASSERT_EQ(int(key), table.find(key)->second);
+}
@@ -0,0 +1,71 @@
+#include "IntrusiveHashTable.h"
+
+#include <vector>
+
+#include <gtest.h>
+
+
+struct Record : public IntrusiveListHook<Record> {
+    KeyType key;
+    int value;
+
+    Record(KeyType key = 0, int value = 0) : key(key), value(value) {}
+};
+
+using RecordTable = IntrusiveHashTable<Record, MemberKey<Record, &Record::key>>;
+
+
+TEST(TestIntrusiveHashTable, find_returns_inserted_object) {
+    RecordTable table;
+    Record record(5, 10);
+    table.insert(record);
+
+    EXPECT_EQ(&record, table.find(5));
+    EXPECT_EQ(nullptr, table.find(6));
+}
+
+TEST(TestIntrusiveHashTable, cant_insert_existing_key) {
+    RecordTable table;
+    Record record1(5, 10), record2(5, 20);
+
+    EXPECT_TRUE(table.insert(record1));
+    EXPECT_FALSE(table.insert(record2));
+    EXPECT_EQ(10, table.find(5)->value);
+    EXPECT_EQ(1, table.getSize());
+}
+
+TEST(TestIntrusiveHashTable, can_erase_object) {
+    RecordTable table;
+    Record record(5, 10);
+    table.insert(record);
+
+    EXPECT_EQ(&record, table.erase(5));
+    EXPECT_EQ(nullptr, table.erase(5));
+    EXPECT_EQ(nullptr, table.find(5));
+    EXPECT_TRUE(table.isEmpty());
+}
+
+TEST(TestIntrusiveHashTable, objects_are_found_after_repack) {
+    RecordTable table;
+    std::vector<Record> records;
+    for (KeyType key = 0; key < 1000; key++)
+        records.push_back(Record(key * 7, int(key)));
+    for (Record& record : records)
+        table.insert(record);
+
+    for (Record& record : records)
+        ASSERT_EQ(&record, table.find(record.key));
+    EXPECT_EQ(1000, table.getSize());
+}
+
+TEST(TestIntrusiveHashTable, can_reinsert_objects_after_clear) {
+    RecordTable table;
+    Record record1(1, 10), record2(2, 20);
+    table.insert(record1);
+    table.insert(record2);
+    table.clear();
+
+    EXPECT_EQ(nullptr, table.find(1));
+    EXPECT_TRUE(table.insert(record2));
+    EXPECT_EQ(&record2, table.find(2));
+}
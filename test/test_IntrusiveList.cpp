@@ -0,0 +1,102 @@
+#include "IntrusiveList.h"
+
+#include <vector>
+
+#include <gtest.h>
+
+
+// object in two lists: by base hook and by member hook
+struct Item : public IntrusiveListHook<Item> {
+    int value;
+    IntrusiveDoublyLinkedListHook<Item> orderHook;
+
+    Item(int value = 0) : value(value) {}
+};
+
+using OrderList = IntrusiveDoublyLinkedList<Item,
+    MemberHookAccess<Item, IntrusiveDoublyLinkedListHook<Item>, &Item::orderHook>>;
+
+
+class TestIntrusiveList : public testing::Test {
+public:
+
+    Item items[4] = { Item(1), Item(2), Item(3), Item(4) };
+    IntrusiveList<Item> list;
+    OrderList orderList;
+
+    template <class ListType>
+    std::vector<int> getValues(const ListType& l) {
+        std::vector<int> values;
+        for (const Item& item : l)
+            values.push_back(item.value);
+        return values;
+    }
+};
+
+
+TEST_F(TestIntrusiveList, can_push_front_and_pop_front) {
+    for (Item& item : items)
+        list.pushFront(item);
+    list.popFront();
+
+    EXPECT_EQ(std::vector<int>({ 3, 2, 1 }), getValues(list));
+    EXPECT_EQ(3, list.getSize());
+    EXPECT_EQ(nullptr, items[3].next);
+}
+
+TEST_F(TestIntrusiveList, links_objects_without_copying) {
+    list.pushFront(items[0]);
+    list.insertAfter(items[1], &items[0]);
+
+    EXPECT_EQ(&items[0], list.getFirst());
+    EXPECT_EQ(&items[1], list.findFirst([](const Item& item) { return item.value == 2; }));
+}
+
+TEST_F(TestIntrusiveList, can_erase_first) {
+    for (Item& item : items)
+        list.pushFront(item);
+
+    EXPECT_EQ(&items[1], list.eraseFirst([](const Item& item) { return item.value == 2; }));
+    EXPECT_EQ(nullptr, list.eraseFirst([](const Item& item) { return item.value == 2; }));
+    EXPECT_EQ(std::vector<int>({ 4, 3, 1 }), getValues(list));
+}
+
+TEST_F(TestIntrusiveList, object_can_be_in_two_lists) {
+    for (Item& item : items) {
+        list.pushFront(item);
+        orderList.pushBack(item);
+    }
+    orderList.erase(items[1]);
+    list.popFront();
+
+    EXPECT_EQ(std::vector<int>({ 3, 2, 1 }), getValues(list));
+    EXPECT_EQ(std::vector<int>({ 1, 3, 4 }), getValues(orderList));
+}
+
+TEST_F(TestIntrusiveList, doubly_linked_list_can_pop_back) {
+    for (Item& item : items)
+        orderList.pushFront(item);
+    orderList.popBack();
+    orderList.popBack();
+
+    EXPECT_EQ(&items[2], orderList.getLast());
+    EXPECT_EQ(std::vector<int>({ 4, 3 }), getValues(orderList));
+}
+
+TEST_F(TestIntrusiveList, copy_of_object_is_not_linked) {
+    list.pushFront(items[0]);
+    list.pushFront(items[1]);
+    Item copy(items[1]);
+
+    EXPECT_EQ(nullptr, copy.next);
+}
+
+TEST_F(TestIntrusiveList, clear_unlinks_objects) {
+    for (Item& item : items)
+        orderList.pushBack(item);
+    orderList.clear();
+
+    EXPECT_TRUE(orderList.empty());
+    for (Item& item : items)
+        EXPECT_EQ(nullptr, item.orderHook.next);
+}
@@ -0,0 +1,183 @@
+#include "LatencyHistogram.h"
+#include "HashTableOpenAddressing.h"
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <gtest.h>
+
+
+TEST(TestLatencyHistogram, small_values_are_counted_exactly) {
+    for (uint64_t value = 0; value < SUB_BINS_LATENCY_HISTOGRAM; value++) {
+        size_t index = LatencyHistogram::getBinIndex(value);
+        ASSERT_EQ(value, LatencyHistogram::getBinLowest(index));
+        ASSERT_EQ(value, LatencyHistogram::getBinHighest(index));
+    }
+}
+
+TEST(TestLatencyHistogram, bin_contains_value_with_small_relative_error) {
+    std::mt19937_64 gen(1);
+    for (int i = 0; i < 10000; i++) {
+        uint64_t value = gen() >> (gen() % 64);
+        size_t index = LatencyHistogram::getBinIndex(value);
+        ASSERT_LT(index, BINS_LATENCY_HISTOGRAM);
+        ASSERT_LE(LatencyHistogram::getBinLowest(index), value);
+        ASSERT_GE(LatencyHistogram::getBinHighest(index), value);
+        ASSERT_LE(LatencyHistogram::getBinHighest(index) - LatencyHistogram::getBinLowest(index),
+            value / SUB_BINS_LATENCY_HISTOGRAM);
+    }
+    ASSERT_EQ(BINS_LATENCY_HISTOGRAM - 1, LatencyHistogram::getBinIndex(UINT64_MAX));
+}
+
+TEST(TestLatencyHistogram, bins_follow_each_other) {
+    for (size_t i = 0; i + 1 < BINS_LATENCY_HISTOGRAM; i++)
+        ASSERT_EQ(LatencyHistogram::getBinHighest(i) + 1, LatencyHistogram::getBinLowest(i + 1));
+}
+
+TEST(TestLatencyHistogram, can_get_percentiles) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 10000; value++)
+        histogram.record(value);
+
+    EXPECT_EQ(10000, histogram.getCount());
+    EXPECT_NEAR(5000, histogram.getValueAtPercentile(0.5), 5000 / 32);
+    EXPECT_NEAR(9900, histogram.getValueAtPercentile(0.99), 9900 / 32);
+    EXPECT_NEAR(9990, histogram.getValueAtPercentile(0.999), 9990 / 32);
+    EXPECT_EQ(10000, histogram.getValueAtPercentile(1));
+    EXPECT_EQ(10000, histogram.getSummary().max);
+}
+
+TEST(TestLatencyHistogram, empty_histogram_gives_zeros) {
+    LatencyHistogram histogram;
+
+    EXPECT_EQ(0, histogram.getValueAtPercentile(0.5));
+    EXPECT_EQ(0, histogram.getMax());
+}
+
+TEST(TestLatencyHistogram, can_merge_histograms) {
+    LatencyHistogram histogram1, histogram2;
+    for (uint64_t value = 0; value < 100; value++)
+        histogram1.record(10);
+    histogram2.record(1000);
+
+    histogram1.merge(histogram2);
+
+    EXPECT_EQ(101, histogram1.getCount());
+    EXPECT_EQ(10, histogram1.getValueAtPercentile(0.99));
+    EXPECT_EQ(1000, histogram1.getMax());
+}
+
+
+TEST(TestInstrumentedTable, records_latencies_of_operations) {
+    InstrumentedTable<HashTableOpenAddressing<std::string>> table;
+    for (KeyType key = 0; key < 100; key++)
+        table.insert(key, "a");
+    for (KeyType key = 0; key < 200; key++)
+        table.find(key);
+    table.erase(5);
+    table.upsert(5, "b");
+
+    EXPECT_EQ(100, table.getLatencies(TableOperation::INSERT).getCount());
+    EXPECT_EQ(200, table.getLatencies(TableOperation::FIND).getCount());
+    EXPECT_EQ(1, table.getLatencies(TableOperation::ERASE).getCount());
+    EXPECT_EQ(1, table.getLatencies(TableOperation::FIND_OR_INSERT).getCount());
+    EXPECT_EQ("b", table.find(5)->second);
+    EXPECT_EQ(100, table.getSize());
+}
+
+TEST(TestInstrumentedTable, measures_every_nth_operation_with_sampling) {
+    InstrumentedTable<HashTableOpenAddressing<std::string>> table;
+    table.setSamplingPeriod(10);
+    for (KeyType key = 0; key < 100; key++)
+        table.find(key);
+
+    EXPECT_EQ(10, table.getLatencies(TableOperation::FIND).getCount());
+    EXPECT_ANY_THROW(table.setSamplingPeriod(0));
+}
+
+TEST(TestInstrumentedTable, merges_latencies_of_threads) {
+    InstrumentedTable<HashTableOpenAddressing<int>> table;
+    for (KeyType key = 0; key < 1000; key++)
+        table.insert(key, int(key));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+        threads.emplace_back([&table]() {
+            for (KeyType key = 0; key < 1000; key++)
+                table.find(key);
+        });
+    for (std::thread& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(4000, table.getLatencies(TableOperation::FIND).getCount());
+}
+
+TEST(TestInstrumentedTable, tables_have_separate_latencies) {
+    InstrumentedTable<HashTableOpenAddressing<int>> table1, table2;
+    table1.find(1);
+    table2.find(1);
+    table1.find(2);
+
+    EXPECT_EQ(2, table1.getLatencies(TableOperation::FIND).getCount());
+    EXPECT_EQ(1, table2.getLatencies(TableOperation::FIND).getCount());
+}
+
+TEST(TestInstrumentedTable, thread_caches_all_used_tables) {
+    InstrumentedTable<HashTableOpenAddressing<int>> table1, table2;
+    size_t cachedTables = 0;
+
+    std::thread thread([&]() {
+        for (KeyType key = 0; key < 100; key++) {
+            table1.find(key);
+            table2.find(key);
+        }
+        cachedTables = getThreadLatenciesCache().tables.size();
+    });
+    thread.join();
+
+    EXPECT_EQ(2, cachedTables);
+    EXPECT_EQ(100, table1.getLatencies(TableOperation::FIND).getCount());
+    EXPECT_EQ(100, table2.getLatencies(TableOperation::FIND).getCount());
+}
+
+TEST(TestInstrumentedTable, thread_cache_drops_destroyed_tables) {
+    size_t cachedTables = 0;
+
+    std::thread thread([&]() {
+        for (int i = 0; i < 1000; i++) {
+            InstrumentedTable<HashTableOpenAddressing<int>> table;
+            table.find(1);
+        }
+        cachedTables = getThreadLatenciesCache().tables.size();
+    });
+    thread.join();
+
+    EXPECT_LE(cachedTables, 16);
+}
+
+TEST(TestInstrumentedTable, can_reset_and_dump_latencies) {
+    TableAdapter<InstrumentedTable<HashTableOpenAddressing<int>>> adapter;
+    TableInterface<int>& table = adapter;
+    table.insert(1, 1);
+    table.find(1);
+
+    std::ostringstream ostr;
+    adapter.getTable().dumpLatencies(ostr);
+    EXPECT_NE(std::string::npos, ostr.str().find("find latencies"));
+    EXPECT_EQ(std::string::npos, ostr.str().find("erase latencies"));
+
+    adapter.getTable().resetLatencies();
+    EXPECT_EQ(0, adapter.getTable().getLatencies(TableOperation::FIND).getCount());
+}
+
+// the forwarding constructor doesn't take an instrumented table, so it isn't a copy constructor
+TEST(TestInstrumentedTable, is_not_copyable) {
+    typedef InstrumentedTable<HashTableOpenAddressing<int>> TableType;
+    EXPECT_FALSE((std::is_constructible<TableType, TableType&>::value));
+    EXPECT_FALSE((std::is_constructible<TableType, const TableType&>::value));
+    EXPECT_TRUE((std::is_constructible<TableType, HashTablePolicy>::value));
+}
@@ -1,5 +1,9 @@
 #include "List.h"
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 #include <gtest.h>
 
 class TestList : public testing::Test {
@@ -88,3 +92,217 @@ TEST_F(TestList, can_erase_after) {
 }
 
 
+
+TEST_F(TestList, can_use_std_allocator) {
+    List<int, std::allocator<int>> list2;
+    list2.pushFront(2);
+    list2.pushFront(1);
+    list2.popBack();
+    EXPECT_EQ(list2.getFirst()->data, 1);
+    EXPECT_EQ(list2.getFirst()->next, nullptr);
+}
+
+TEST_F(TestList, reuses_freed_nodes) {
+    Node<int>* node = list.getFirst();
+    list.popFront();
+    EXPECT_EQ(list.pushFront(10), node);
+}
+
+TEST_F(TestList, clear_releases_slabs_of_pool) {
+    BlockPool* pool = list.getAllocator().getPool().get();
+    list.clear();
+    EXPECT_EQ(0, pool->getSlabsCount());
+}
+
+TEST_F(TestList, copies_of_list_share_pool) {
+    List<int> list2(list);
+    EXPECT_EQ(list.getAllocator(), list2.getAllocator());
+    EXPECT_EQ(6, list.getAllocator().getPool()->getUsedBlocks());
+}
+
+TEST_F(TestList, push_back_updates_last_node) {
+    list.pushBack(4);
+    list.popFront();
+    list.pushBack(5);
+
+    EXPECT_EQ(list.getLast()->data, 5);
+    EXPECT_EQ(list.getLast()->next, nullptr);
+    EXPECT_EQ(list.getFirst()->next->next->data, 4);
+}
+
+TEST_F(TestList, erasing_last_node_updates_last_node) {
+    list.eraseAfter(list.getFirst()->next);
+    EXPECT_EQ(list.getLast()->data, 2);
+
+    list.popBack();
+    list.popBack();
+    EXPECT_EQ(list.getLast(), nullptr);
+}
+
+TEST_F(TestList, size_is_correct) {
+    list.pushBack(4);
+    list.insertAfter(5, list.getFirst());
+    list.eraseAfter();
+
+    EXPECT_EQ(4, list.getSize());
+    list.clear();
+    EXPECT_EQ(0, list.getSize());
+}
+
+TEST_F(TestList, lists_of_different_sizes_are_not_equal) {
+    List<int> list2(list);
+    list2.popBack();
+
+    EXPECT_NE(list, list2);
+    EXPECT_NE(list2, list);
+}
+
+TEST_F(TestList, can_move_list_without_copying_nodes) {
+    Node<int>* first = list.getFirst();
+    List<int> list2(std::move(list));
+
+    EXPECT_EQ(first, list2.getFirst());
+    EXPECT_EQ(3, list2.getSize());
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(0, list.getSize());
+}
+
+TEST_F(TestList, can_move_assign_list_with_shared_pool) {
+    List<int> list2(list.getAllocator());
+    Node<int>* first = list.getFirst();
+    list2.pushFront(10);
+    list2 = std::move(list);
+
+    EXPECT_EQ(first, list2.getFirst());
+    EXPECT_EQ(3, list2.getLast()->data);
+    EXPECT_TRUE(list.empty());
+}
+
+TEST_F(TestList, can_move_assign_list_with_other_pool) {
+    List<int> list2;
+    list2 = std::move(list);
+
+    EXPECT_EQ(3, list2.getSize());
+    EXPECT_EQ(list2.getFirst()->next->next, list2.getLast());
+    EXPECT_TRUE(list.empty());
+}
+
+TEST_F(TestList, can_splice_whole_list) {
+    List<int> list2(list.getAllocator());
+    list2.pushBack(10);
+    list2.pushBack(20);
+    list.spliceAfter(list.getFirst(), list2);
+
+    List<int> expected;
+    for (int x : { 1, 10, 20, 2, 3 }) expected.pushBack(x);
+    EXPECT_EQ(expected, list);
+    EXPECT_TRUE(list2.empty());
+    EXPECT_EQ(0, list2.getSize());
+}
+
+TEST_F(TestList, can_splice_to_the_end) {
+    List<int> list2(list.getAllocator());
+    list2.pushBack(10);
+    list.spliceAfter(list.getLast(), list2);
+    list.pushBack(20);
+
+    EXPECT_EQ(5, list.getSize());
+    EXPECT_EQ(20, list.getLast()->data);
+    EXPECT_EQ(10, list.getFirst()->next->next->next->data);
+}
+
+TEST_F(TestList, can_splice_range) {
+    List<int> list2(list.getAllocator());
+    list2.pushBack(10);
+    list2.spliceAfter(list2.getFirst(), list, list.getFirst(), list.getLast(), 2);  // nodes 2, 3
+
+    EXPECT_EQ(1, list.getSize());
+    EXPECT_EQ(list.getFirst(), list.getLast());
+    EXPECT_EQ(3, list2.getSize());
+    EXPECT_EQ(3, list2.getLast()->data);
+}
+
+TEST_F(TestList, throws_when_splice_lists_with_different_allocators) {
+    List<int> list2;
+    list2.pushBack(10);
+
+    EXPECT_ANY_THROW(list.spliceAfter(nullptr, list2));
+}
+
+TEST_F(TestList, can_sort_list) {
+    List<int> list2;
+    for (int x : { 5, 1, 4, 1, 3, 9, 2, 6 }) list2.pushBack(x);
+    list2.sort();
+
+    List<int> expected;
+    for (int x : { 1, 1, 2, 3, 4, 5, 6, 9 }) expected.pushBack(x);
+    EXPECT_EQ(expected, list2);
+    EXPECT_EQ(9, list2.getLast()->data);
+    EXPECT_EQ(nullptr, list2.getLast()->next);
+}
+
+TEST_F(TestList, sort_relinks_nodes) {
+    Node<int>* node = list.getFirst();
+    list.sort(std::greater<int>());
+
+    EXPECT_EQ(node, list.getLast());
+    EXPECT_EQ(3, list.getFirst()->data);
+}
+
+TEST_F(TestList, sort_is_stable) {
+    List<std::pair<int, int>> list2;
+    for (int i = 0; i < 100; i++) list2.pushBack(std::make_pair(i % 3, i));
+    list2.sort([](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; });
+
+    std::vector<std::pair<int, int>> elements(list2.begin(), list2.end());
+    EXPECT_TRUE(std::is_sorted(elements.begin(), elements.end()));
+}
+
+TEST_F(TestList, can_merge_sorted_lists) {
+    List<int> list2(list.getAllocator());
+    for (int x : { 0, 2, 5 }) list2.pushBack(x);
+    list.merge(list2);
+
+    List<int> expected;
+    for (int x : { 0, 1, 2, 2, 3, 5 }) expected.pushBack(x);
+    EXPECT_EQ(expected, list);
+    EXPECT_EQ(5, list.getLast()->data);
+    EXPECT_TRUE(list2.empty());
+}
+
+TEST_F(TestList, can_merge_with_empty_list) {
+    List<int> list2(list.getAllocator());
+    list2.merge(list);
+
+    EXPECT_EQ(3, list2.getSize());
+    EXPECT_EQ(3, list2.getLast()->data);
+}
+
+TEST_F(TestList, parallel_sort_gives_the_same_result_as_sort) {
+    List<std::pair<int, int>> list1, list2;
+    std::mt19937 gen(1);
+    for (int i = 0; i < 100000; i++) {
+        std::pair<int, int> elem(int(gen() % 1000), i);
+        list1.pushBack(elem);
+        list2.pushBack(elem);
+    }
+    auto compare = [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; };
+    list1.sort(compare);
+    list2.parallelSort(3, compare);
+
+    EXPECT_EQ(list1, list2);
+    EXPECT_EQ(list1.getLast()->data, list2.getLast()->data);
+    EXPECT_EQ(nullptr, list2.getLast()->next);
+}
+
+TEST_F(TestList, move_all_to_relinks_nodes) {
+    List<int> odd(list.getAllocator()), even(list.getAllocator());
+    Node<int>* node = list.getFirst();
+    list.moveAllTo([&](int x) -> List<int>& { return x % 2 ? odd : even; });
+
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(2, odd.getSize());
+    EXPECT_EQ(node, odd.getLast());
+    EXPECT_EQ(2, even.getFirst()->data);
+    EXPECT_EQ(3, list.getAllocator().getPool()->getUsedBlocks());
+}
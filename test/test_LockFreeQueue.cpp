@@ -0,0 +1,68 @@
+#include "LockFreeQueue.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest.h>
+
+
+TEST(TestLockFreeQueue, pop_from_empty_queue_returns_false) {
+    LockFreeQueue<int> queue;
+    int data = 0;
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.pop(data));
+}
+
+TEST(TestLockFreeQueue, pops_elements_in_order_of_pushing) {
+    LockFreeQueue<std::string> queue;
+    queue.push("a");
+    queue.push("b");
+    queue.push("c");
+
+    std::string data;
+    for (const char* expected : { "a", "b", "c" }) {
+        ASSERT_TRUE(queue.pop(data));
+        EXPECT_EQ(expected, data);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(TestLockFreeQueue, every_element_is_popped_once_by_concurrent_threads) {
+    const int producersCount = 2, consumersCount = 2, n = 20000;
+    LockFreeQueue<int> queue;
+    std::vector<std::vector<int>> popped(consumersCount);
+    std::atomic<int> poppedCount{ 0 };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < producersCount; t++)
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < n; i++)
+                queue.push(t * n + i);
+        });
+    for (int t = 0; t < consumersCount; t++)
+        threads.emplace_back([&, t]() {
+            int data;
+            while (poppedCount.load() < producersCount * n)
+                if (queue.pop(data)) {
+                    popped[t].push_back(data);
+                    poppedCount++;
+                }
+        });
+    for (std::thread& thread : threads)
+        thread.join();
+
+    // elements of one producer are popped by one consumer in order of pushing
+    std::vector<int> counts(producersCount * n);
+    for (const std::vector<int>& elements : popped) {
+        std::vector<int> last(producersCount, -1);
+        for (int data : elements) {
+            counts[data]++;
+            ASSERT_LT(last[data / n], data);
+            last[data / n] = data;
+        }
+    }
+    for (int count : counts)
+        ASSERT_EQ(1, count);
+}
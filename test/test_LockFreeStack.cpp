@@ -0,0 +1,67 @@
+#include "LockFreeStack.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest.h>
+
+
+TEST(TestLockFreeStack, pop_from_empty_stack_returns_false) {
+    LockFreeStack<int> stack;
+    int data = 0;
+
+    EXPECT_TRUE(stack.empty());
+    EXPECT_FALSE(stack.pop(data));
+}
+
+TEST(TestLockFreeStack, pops_elements_in_reverse_order) {
+    LockFreeStack<int> stack;
+    for (int i = 0; i < 3; i++)
+        stack.push(i);
+
+    int data = 0;
+    for (int i = 2; i >= 0; i--) {
+        ASSERT_TRUE(stack.pop(data));
+        EXPECT_EQ(i, data);
+    }
+    EXPECT_TRUE(stack.empty());
+}
+
+TEST(TestLockFreeStack, popped_nodes_are_reclaimed) {
+    LockFreeStack<std::string> stack;
+    for (int i = 0; i < 100; i++)
+        stack.push(std::to_string(i));
+    std::string data;
+    while (stack.pop(data)) {}
+
+    EXPECT_EQ(0, HazardPointers::reclaim());
+}
+
+TEST(TestLockFreeStack, every_element_is_popped_once_by_concurrent_threads) {
+    const int threadsCount = 4, n = 20000;
+    LockFreeStack<int> stack;
+    std::vector<std::vector<int>> popped(threadsCount);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadsCount; t++)
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < n; i++) {
+                stack.push(t * n + i);
+                int data;
+                if (i % 2 && stack.pop(data)) popped[t].push_back(data);
+            }
+        });
+    for (std::thread& thread : threads)
+        thread.join();
+
+    std::vector<int> counts(threadsCount * n);
+    for (const std::vector<int>& elements : popped)
+        for (int data : elements)
+            counts[data]++;
+    int data;
+    while (stack.pop(data))
+        counts[data]++;
+    for (int count : counts)
+        ASSERT_EQ(1, count);
+}
@@ -0,0 +1,172 @@
+#include "PerfectHashTable.h"
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <gtest.h>
+
+
+std::vector<std::pair<KeyType, int>> generateRandomElements(size_t n, uint32_t seed = 1) {
+    std::mt19937 gen(seed);
+    std::unordered_set<KeyType> keys;
+    std::vector<std::pair<KeyType, int>> res;
+    while (res.size() < n) {
+        KeyType key = KeyType(gen());
+        if (keys.insert(key).second) res.push_back(std::make_pair(key, int(res.size())));
+    }
+    return res;
+}
+
+
+TEST(TestPerfectHashTable, can_find_all_elements) {
+    std::vector<std::pair<KeyType, int>> elems = generateRandomElements(100000);
+    PerfectHashTable<int> table(elems);
+
+    EXPECT_EQ(elems.size(), table.getSize());
+    for (const std::pair<KeyType, int>& elem : elems)
+        ASSERT_EQ(elem.second, table.find(elem.first)->second);
+}
+
+TEST(TestPerfectHashTable, absent_keys_are_not_found) {
+    std::vector<std::pair<KeyType, int>> elems;
+    for (KeyType key = 0; key < 1000; key++)
+        elems.push_back(std::make_pair(key * 2, int(key)));
+    PerfectHashTable<int> table(elems);
+
+    for (KeyType key = 0; key < 1000; key++)
+        ASSERT_EQ(nullptr, table.find(key * 2 + 1));
+}
+
+TEST(TestPerfectHashTable, hash_function_takes_about_3_bits_per_key) {
+    PerfectHashTable<int> table(generateRandomElements(100000));
+
+    EXPECT_LT(table.getBitsPerKey(), 3.5);
+    EXPECT_LT(table.getLevelCount(), MAX_LEVELS_PERFECT_HASH_TABLE);
+}
+
+TEST(TestPerfectHashTable, larger_gamma_makes_fewer_levels) {
+    std::vector<std::pair<KeyType, int>> elems = generateRandomElements(10000);
+    PerfectHashTable<int> table1(elems, 1), table4(elems, 4);
+
+    EXPECT_LT(table4.getLevelCount(), table1.getLevelCount());
+    EXPECT_LT(table1.getBitsPerKey(), table4.getBitsPerKey());
+}
+
+TEST(TestPerfectHashTable, can_build_small_and_empty_tables) {
+    PerfectHashTable<int> empty((std::vector<std::pair<KeyType, int>>()));
+    PerfectHashTable<int> one(std::vector<std::pair<KeyType, int>>{ { 5, 1 } });
+
+    EXPECT_TRUE(empty.isEmpty());
+    EXPECT_EQ(nullptr, empty.find(5));
+    EXPECT_EQ(1, one.find(5)->second);
+    EXPECT_EQ(nullptr, one.find(6));
+}
+
+TEST(TestPerfectHashTable, throws_if_keys_are_repeated) {
+    std::vector<std::pair<KeyType, int>> elems = { { 1, 1 }, { 2, 2 }, { 1, 3 } };
+
+    EXPECT_ANY_THROW(PerfectHashTable<int> table(elems));
+    EXPECT_ANY_THROW(PerfectHashTable<int> table(generateRandomElements(10), 0.5));
+}
+
+TEST(TestPerfectHashTable, can_save_and_load_table) {
+    std::vector<std::pair<KeyType, int>> elems = generateRandomElements(10000);
+    PerfectHashTable<int> table(elems);
+    std::stringstream stream;
+
+    table.save(stream);
+    PerfectHashTable<int> loaded = PerfectHashTable<int>::load(stream);
+
+    EXPECT_EQ(table.getSize(), loaded.getSize());
+    for (const std::pair<KeyType, int>& elem : elems)
+        ASSERT_EQ(elem.second, loaded.find(elem.first)->second);
+    EXPECT_EQ(nullptr, loaded.find(elems[0].first + 1));
+}
+
+TEST(TestPerfectHashTable, throws_if_stream_contains_other_data) {
+    std::stringstream stream("not a table");
+    EXPECT_ANY_THROW(PerfectHashTable<int>::load(stream));
+
+    std::stringstream doubles;
+    PerfectHashTable<double>(std::vector<std::pair<KeyType, double>>{ { 1, 1.0 } }).save(doubles);
+    EXPECT_ANY_THROW(PerfectHashTable<int>::load(doubles));
+}
+
+template <class T>
+void writeValue(std::ostream& ostr, const T& value) {
+    ostr.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// saved table with one element and one level, the first bit of the bit array is set
+std::string makeSavedTable(uint64_t levelOffset, uint64_t levelSize) {
+    std::ostringstream ostr;
+    writeValue(ostr, MAGIC_PERFECT_HASH_TABLE);
+    writeValue(ostr, uint32_t(sizeof(std::pair<KeyType, int>)));
+    writeValue(ostr, uint64_t(1));  // bits
+    writeValue(ostr, uint64_t(1));
+    writeValue(ostr, uint64_t(1));  // level offsets
+    writeValue(ostr, levelOffset);
+    writeValue(ostr, uint64_t(1));  // level sizes
+    writeValue(ostr, levelSize);
+    writeValue(ostr, uint64_t(0));  // fallback keys
+    writeValue(ostr, uint64_t(1));  // elements
+    writeValue(ostr, std::pair<KeyType, int>(7, 70));
+    return ostr.str();
+}
+
+TEST(TestPerfectHashTable, throws_if_levels_are_out_of_bit_array) {
+    std::istringstream valid(makeSavedTable(0, 64));
+    EXPECT_EQ(1, PerfectHashTable<int>::load(valid).getSize());
+
+    for (std::pair<uint64_t, uint64_t> level : std::vector<std::pair<uint64_t, uint64_t>>{
+        { 0, 0 }, { 64, 64 }, { 32, 64 }, { 0, 128 }, { ~uint64_t(0) - 10, 64 } }) {
+        std::istringstream stream(makeSavedTable(level.first, level.second));
+        EXPECT_ANY_THROW(PerfectHashTable<int>::load(stream));
+    }
+}
+
+TEST(TestPerfectHashTable, throws_if_stream_is_truncated) {
+    std::string saved = makeSavedTable(0, 64);
+    for (size_t length = 0; length < saved.size(); length++) {
+        std::istringstream stream(saved.substr(0, length));
+        EXPECT_THROW(PerfectHashTable<int>::load(stream), const char*);
+    }
+}
+
+// huge sizes of the bit array and the elements are followed by a few values, nothing huge is allocated
+TEST(TestPerfectHashTable, throws_if_sizes_are_huge) {
+    std::string saved = makeSavedTable(0, 64);
+    size_t bitsOffset = 2 * sizeof(uint32_t);
+    size_t elementsOffset = saved.size() - sizeof(std::pair<KeyType, int>) - sizeof(uint64_t);
+
+    for (size_t offset : { bitsOffset, elementsOffset })
+        for (uint64_t size : { uint64_t(1) << 40, ~uint64_t(0) }) {
+            std::string corrupt = saved;
+            corrupt.replace(offset, sizeof(size), reinterpret_cast<const char*>(&size), sizeof(size));
+            std::istringstream stream(corrupt);
+            EXPECT_THROW(PerfectHashTable<int>::load(stream), const char*);
+        }
+}
+
+TEST(TestPerfectHashTable, can_be_used_by_readable_interface) {
+    ReadableTableAdapter<PerfectHashTable<int>> adapter(std::vector<std::pair<KeyType, int>>{ { 1, 10 }, { 2, 20 } });
+    ReadableTableInterface<int>& table = adapter;
+
+    EXPECT_EQ(20, table.find(2)->second);
+    EXPECT_EQ(nullptr, table.find(3));
+    EXPECT_EQ(2, table.getSize());
+    EXPECT_EQ(2 * sizeof(std::pair<KeyType, int>), table.getMemoryUsage().elementBytes);
+}
+
+TEST(TestPerfectHashTable, readable_adapter_can_be_copied) {
+    ReadableTableAdapter<PerfectHashTable<int>> adapter(std::vector<std::pair<KeyType, int>>{ { 1, 10 }, { 2, 20 } });
+
+    ReadableTableAdapter<PerfectHashTable<int>> copy(adapter);
+
+    EXPECT_EQ(10, copy.find(1)->second);
+    EXPECT_EQ(2, copy.getSize());
+}
@@ -0,0 +1,75 @@
+#include "PoolAllocator.h"
+
+#include <cstdint>
+
+#include <gtest.h>
+
+
+TEST(TestPoolAllocator, allocates_blocks_from_one_slab) {
+    PoolAllocator<int64_t> allocator;
+    int64_t* ptr1 = allocator.allocate(1);
+    int64_t* ptr2 = allocator.allocate(1);
+
+    EXPECT_EQ(ptr1 + 1, ptr2);
+    EXPECT_EQ(1, allocator.getPool()->getSlabsCount());
+
+    allocator.deallocate(ptr1, 1);
+    allocator.deallocate(ptr2, 1);
+}
+
+TEST(TestPoolAllocator, adds_slabs_when_pool_is_full) {
+    PoolAllocator<int64_t> allocator;
+    std::vector<int64_t*> ptrs;
+    for (size_t i = 0; i < START_SLAB_SIZE_BLOCK_POOL + 1; i++)
+        ptrs.push_back(allocator.allocate(1));
+
+    EXPECT_EQ(2, allocator.getPool()->getSlabsCount());
+    EXPECT_EQ(START_SLAB_SIZE_BLOCK_POOL + 1, allocator.getPool()->getUsedBlocks());
+
+    for (int64_t* ptr : ptrs)
+        allocator.deallocate(ptr, 1);
+    EXPECT_EQ(0, allocator.getPool()->getUsedBlocks());
+}
+
+TEST(TestPoolAllocator, reuses_freed_blocks) {
+    PoolAllocator<int64_t> allocator;
+    int64_t* ptr1 = allocator.allocate(1);
+    allocator.deallocate(ptr1, 1);
+
+    int64_t* ptr2 = allocator.allocate(1);
+
+    EXPECT_EQ(ptr1, ptr2);
+    allocator.deallocate(ptr2, 1);
+}
+
+TEST(TestPoolAllocator, copies_share_pool) {
+    PoolAllocator<int64_t> allocator1;
+    PoolAllocator<int64_t> allocator2(allocator1);
+    PoolAllocator<int32_t> allocator3(allocator1);
+
+    EXPECT_EQ(allocator1, allocator2);
+    EXPECT_EQ(allocator1, allocator3);
+    EXPECT_NE(allocator1, PoolAllocator<int64_t>());
+}
+
+TEST(TestPoolAllocator, releases_unused_memory_only_if_pool_is_not_shared) {
+    PoolAllocator<int64_t> allocator1;
+    allocator1.deallocate(allocator1.allocate(1), 1);
+    {
+        PoolAllocator<int64_t> allocator2(allocator1);
+        allocator1.releaseUnusedMemory();
+        EXPECT_EQ(1, allocator1.getPool()->getSlabsCount());
+    }
+
+    allocator1.releaseUnusedMemory();
+
+    EXPECT_EQ(0, allocator1.getPool()->getSlabsCount());
+}
+
+TEST(TestPoolAllocator, arrays_are_not_taken_from_pool) {
+    PoolAllocator<int64_t> allocator;
+    int64_t* ptr = allocator.allocate(10);
+
+    EXPECT_EQ(0, allocator.getPool()->getUsedBlocks());
+    allocator.deallocate(ptr, 10);
+}
@@ -0,0 +1,79 @@
+#include "SmallVectorBucket.h"
+#include "PoolAllocator.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest.h>
+
+
+class TestSmallVectorBucket : public testing::Test {
+public:
+
+    SmallVectorBucket<std::string> bucket;
+
+    TestSmallVectorBucket() {
+        for (int i = 0; i < 5; i++)  // two elements are inline, three are in overflow
+            bucket.pushBack(std::to_string(i));
+    }
+
+    std::vector<std::string> toVector(const SmallVectorBucket<std::string>& b) {
+        return std::vector<std::string>(b.begin(), b.end());
+    }
+};
+
+
+TEST_F(TestSmallVectorBucket, can_push_back_and_iterate) {
+    EXPECT_EQ(std::vector<std::string>({ "0", "1", "2", "3", "4" }), toVector(bucket));
+    EXPECT_EQ(5, bucket.getSize());
+}
+
+TEST_F(TestSmallVectorBucket, can_push_front) {
+    bucket.pushFront("a");
+
+    EXPECT_EQ(std::vector<std::string>({ "a", "0", "1", "2", "3", "4" }), toVector(bucket));
+}
+
+TEST_F(TestSmallVectorBucket, can_find_inline_and_overflow_elements) {
+    EXPECT_EQ(&bucket[1], bucket.findFirst([](const std::string& s) { return s == "1"; }));
+    EXPECT_EQ(&bucket[4], bucket.findFirst([](const std::string& s) { return s == "4"; }));
+    EXPECT_EQ(nullptr, bucket.findFirst([](const std::string& s) { return s == "5"; }));
+}
+
+TEST_F(TestSmallVectorBucket, erase_keeps_order_of_elements) {
+    EXPECT_TRUE(bucket.eraseFirst([](const std::string& s) { return s == "1"; }));
+    EXPECT_FALSE(bucket.eraseFirst([](const std::string& s) { return s == "1"; }));
+
+    EXPECT_EQ(std::vector<std::string>({ "0", "2", "3", "4" }), toVector(bucket));
+}
+
+TEST_F(TestSmallVectorBucket, can_copy_and_move_bucket) {
+    SmallVectorBucket<std::string> copy(bucket);
+    EXPECT_EQ(toVector(bucket), toVector(copy));
+
+    SmallVectorBucket<std::string> moved(std::move(copy));
+    EXPECT_EQ(toVector(bucket), toVector(moved));
+    EXPECT_TRUE(copy.empty());
+
+    copy = bucket;
+    moved = std::move(copy);
+    EXPECT_EQ(toVector(bucket), toVector(moved));
+}
+
+TEST_F(TestSmallVectorBucket, can_clear_bucket) {
+    bucket.clear();
+
+    EXPECT_TRUE(bucket.empty());
+    EXPECT_EQ(bucket.begin(), bucket.end());
+}
+
+TEST_F(TestSmallVectorBucket, move_assignment_copies_elements_if_allocators_differ) {
+    SmallVectorBucket<int, PoolAllocator<int>> bucket1, bucket2;
+    for (int i = 0; i < 10; i++)
+        bucket1.pushBack(i);
+    bucket2 = std::move(bucket1);
+
+    EXPECT_EQ(10, bucket2.getSize());
+    EXPECT_EQ(9, bucket2[9]);
+    EXPECT_TRUE(bucket1.empty());
+}
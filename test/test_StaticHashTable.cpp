@@ -0,0 +1,71 @@
+#include "StaticHashTable.h"
+
+#include <string>
+
+#include <gtest.h>
+
+
+enum class Protocol { UNKNOWN, HTTP, HTTPS, SSH, DNS };
+
+constexpr StaticHashTable<Protocol, 4> PROTOCOLS = {
+    { 80, Protocol::HTTP }, { 443, Protocol::HTTPS }, { 22, Protocol::SSH }, { 53, Protocol::DNS }
+};
+
+constexpr auto NAMES = makeStaticHashTable<const char*>({ { 1, "one" }, { 2, "two" }, { 3, "three" } });
+
+// table filled by a loop at compile time
+constexpr StaticHashTable<KeyType, 100> makeSquares() {
+    StaticHashTable<KeyType, 100> table;
+    for (KeyType key = 0; key < 100; key++)
+        table.insert(key * 1000, key * key);
+    return table;
+}
+
+constexpr StaticHashTable<KeyType, 100> SQUARES = makeSquares();
+
+
+// searches are computed by the compiler
+static_assert(PROTOCOLS.at(443) == Protocol::HTTPS, "search in constant expression");
+static_assert(PROTOCOLS.find(8080) == nullptr, "missing key in constant expression");
+static_assert(NAMES.getSize() == 3 && NAMES.contains(2), "size of made table");
+static_assert(SQUARES.at(99000) == 99 * 99, "table filled at compile time");
+static_assert(decltype(SQUARES)::getStorageSize() == 256, "storage size is a power of 2");
+
+
+TEST(TestStaticHashTable, can_find_elements) {
+    EXPECT_EQ(Protocol::SSH, PROTOCOLS.find(22)->second);
+    EXPECT_EQ(22, PROTOCOLS.find(22)->first);
+    EXPECT_EQ(nullptr, PROTOCOLS.find(21));
+    EXPECT_EQ(std::string("three"), NAMES.at(3));
+}
+
+TEST(TestStaticHashTable, can_find_all_keys_of_large_table) {
+    for (KeyType key = 0; key < 100; key++) {
+        ASSERT_EQ(key * key, SQUARES.at(key * 1000));
+        ASSERT_FALSE(SQUARES.contains(key * 1000 + 1));
+    }
+    EXPECT_EQ(100, SQUARES.getSize());
+}
+
+TEST(TestStaticHashTable, throws_if_key_does_not_exist) {
+    EXPECT_ANY_THROW(PROTOCOLS.at(21));
+}
+
+TEST(TestStaticHashTable, throws_if_keys_are_repeated) {
+    EXPECT_ANY_THROW((StaticHashTable<int, 2>{ { 1, 1 }, { 1, 2 } }));
+}
+
+TEST(TestStaticHashTable, throws_if_table_is_full) {
+    StaticHashTable<int, 2> table = { { 1, 1 }, { 2, 2 } };
+
+    EXPECT_FALSE(table.insert(1, 3));
+    EXPECT_ANY_THROW(table.insert(3, 3));
+}
+
+TEST(TestStaticHashTable, has_no_heap_memory) {
+    MemoryUsage usage = PROTOCOLS.getMemoryUsage();
+
+    EXPECT_GE(sizeof(PROTOCOLS), usage.arrayBytes);
+    EXPECT_EQ(4 * sizeof(StaticHashTableEntry<Protocol>), usage.elementBytes);
+    EXPECT_EQ(0, usage.nodeBytes);
+}
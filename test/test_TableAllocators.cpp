@@ -0,0 +1,180 @@
+#include "UnorderedTable.h"
+#include "OrderedTable.h"
+#include "HashTableOpenAddressing.h"
+#include "HashTableSeparateChaining.h"
+#include "DirectAddressTable.h"
+#include "MonotonicArena.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include <gtest.h>
+
+
+typedef std::pair<KeyType, std::string> StringPair;
+typedef ArenaAllocator<StringPair> StringPairArenaAllocator;
+typedef CountingAllocator<StringPair> StringPairCountingAllocator;
+
+// inserts keys 0..n-1 and erases even ones, the table is repacked several times
+template <class TableType>
+void fillTableAndEraseEvenKeys(TableType& table, KeyType n) {
+    for (KeyType key = 0; key < n; key++)
+        table.insert(key, std::to_string(key));
+    for (KeyType key = 0; key < n; key += 2)
+        table.erase(key);
+}
+
+template <class TableType>
+void checkOddKeys(TableType& table, KeyType n) {
+    ASSERT_EQ(n / 2, table.getSize());
+    for (KeyType key = 0; key < n; key++) {
+        if (key % 2)
+            ASSERT_EQ(std::to_string(key), table.find(key)->second);
+        else
+            ASSERT_EQ(nullptr, table.find(key));
+    }
+}
+
+// all memory of the table is taken from the arena
+template <class TableType>
+void checkTableInArena(TableType& table, MonotonicArena& arena) {
+    fillTableAndEraseEvenKeys(table, 1000);
+
+    checkOddKeys(table, 1000);
+    MemoryUsage usage = table.getMemoryUsage();
+    EXPECT_GE(arena.getUsedBytes(), usage.arrayBytes + usage.nodeBytes);
+    table.clear();
+    fillTableAndEraseEvenKeys(table, 100);
+    checkOddKeys(table, 100);
+}
+
+// the counter shows all memory of the table and nothing is leaked
+// arguments are passed to the constructor of the table, they contain allocator with the counter
+template <class TableType, class... Args>
+void checkTableWithCounter(const AllocationCounter& counter, Args&&... args) {
+    {
+        TableType table(std::forward<Args>(args)...);
+        fillTableAndEraseEvenKeys(table, 1000);
+
+        checkOddKeys(table, 1000);
+        MemoryUsage usage = table.getMemoryUsage();
+        EXPECT_EQ(usage.arrayBytes + usage.nodeBytes, counter.bytes);
+        EXPECT_GT(counter.allocations, 0);
+    }
+    EXPECT_EQ(0, counter.bytes);
+    EXPECT_EQ(counter.allocations, counter.deallocations);
+}
+
+
+TEST(TestTableAllocators, unordered_table_can_use_arena) {
+    MonotonicArena arena;
+    UnorderedTable<std::string, StringPairArenaAllocator> table(START_STORAGE_SIZE, SelfOrganizingPolicy::COUNT,
+        StringPairArenaAllocator(arena));
+
+    checkTableInArena(table, arena);
+}
+
+TEST(TestTableAllocators, ordered_table_can_use_arena) {
+    MonotonicArena arena;
+    OrderedTable<std::string, StringPairArenaAllocator> table(START_STORAGE_SIZE, StringPairArenaAllocator(arena));
+
+    checkTableInArena(table, arena);
+}
+
+TEST(TestTableAllocators, direct_address_table_can_use_arena) {
+    MonotonicArena arena;
+    DirectAddressTable<std::string, StringPairArenaAllocator> table(64, 0, StringPairArenaAllocator(arena));
+
+    checkTableInArena(table, arena);
+}
+
+TEST(TestTableAllocators, open_addressing_can_use_arena) {
+    MonotonicArena arena;
+    HashTableOpenAddressing<std::string, StringPair, NoHashTableStatistics, StringPairArenaAllocator>
+        table(3, StringPairArenaAllocator(arena));
+
+    checkTableInArena(table, arena);
+}
+
+TEST(TestTableAllocators, separate_chaining_can_keep_buckets_and_nodes_in_arena) {
+    MonotonicArena arena;
+    HashTableSeparateChaining<std::string, List<StringPair, StringPairArenaAllocator>, NoHashTableStatistics,
+        StringPairArenaAllocator> table(3, StringPairArenaAllocator(arena), StringPairArenaAllocator(arena));
+
+    checkTableInArena(table, arena);
+}
+
+TEST(TestTableAllocators, buckets_of_separate_chaining_share_node_pool) {
+    PoolAllocator<std::pair<KeyType, int>> nodeAllocator;
+    const std::shared_ptr<BlockPool>& pool = nodeAllocator.getPool();
+    HashTableSeparateChaining<int> table(3, std::allocator<std::pair<KeyType, int>>(), nodeAllocator);
+    for (KeyType key = 0; key < 5; key++)
+        table.insert(key, int(key));  // no repack, the buckets are built by the constructor
+
+    EXPECT_EQ(5, pool->getUsedBlocks());
+    EXPECT_EQ(1, pool->getSlabsCount());
+}
+
+TEST(TestTableAllocators, arena_is_released_at_once) {
+    MonotonicArena arena;
+    StringPairArenaAllocator allocator(arena);
+    StringPair* pairs = allocator.allocate(10);
+    ArenaAllocator<double>(allocator).allocate(3);
+
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(pairs) % alignof(StringPair));
+    EXPECT_EQ(10 * sizeof(StringPair) + 3 * sizeof(double), arena.getUsedBytes());
+    arena.release();
+    EXPECT_EQ(0, arena.getAllocatedBytes());
+}
+
+
+TEST(TestTableAllocators, counting_allocator_counts_memory_of_unordered_table) {
+    AllocationCounter counter;
+    checkTableWithCounter<UnorderedTable<std::string, StringPairCountingAllocator>>(counter,
+        START_STORAGE_SIZE, SelfOrganizingPolicy::NONE, StringPairCountingAllocator(counter));
+}
+
+TEST(TestTableAllocators, counting_allocator_counts_memory_of_ordered_table) {
+    AllocationCounter counter;
+    checkTableWithCounter<OrderedTable<std::string, StringPairCountingAllocator>>(counter,
+        START_STORAGE_SIZE, StringPairCountingAllocator(counter));
+}
+
+TEST(TestTableAllocators, counting_allocator_counts_memory_of_direct_address_table) {
+    AllocationCounter counter;
+    checkTableWithCounter<DirectAddressTable<std::string, StringPairCountingAllocator>>(counter,
+        START_WINDOW_SIZE_DIRECT_ADDRESS_TABLE, 0, StringPairCountingAllocator(counter));
+}
+
+TEST(TestTableAllocators, counting_allocator_counts_memory_of_open_addressing) {
+    AllocationCounter counter;
+    checkTableWithCounter<HashTableOpenAddressing<std::string, StringPair, NoHashTableStatistics,
+        StringPairCountingAllocator>>(counter, START_STORAGE_SIZE_DEG_HASH_TABLE, StringPairCountingAllocator(counter));
+}
+
+TEST(TestTableAllocators, counting_allocator_counts_memory_of_separate_chaining) {
+    AllocationCounter counter;
+    checkTableWithCounter<HashTableSeparateChaining<std::string, List<StringPair, StringPairCountingAllocator>,
+        NoHashTableStatistics, StringPairCountingAllocator>>(counter, START_STORAGE_SIZE_DEG_HASH_TABLE,
+        StringPairCountingAllocator(counter), StringPairCountingAllocator(counter));
+    checkTableWithCounter<HashTableSeparateChaining<std::string,
+        SmallVectorBucket<StringPair, StringPairCountingAllocator>, NoHashTableStatistics,
+        StringPairCountingAllocator>>(counter, START_STORAGE_SIZE_DEG_HASH_TABLE,
+        StringPairCountingAllocator(counter), StringPairCountingAllocator(counter));
+}
+
+TEST(TestTableAllocators, table_keeps_stateful_allocator) {
+    AllocationCounter counter;
+    {
+        HashTableOpenAddressing<std::string, StringPair, NoHashTableStatistics, StringPairCountingAllocator>
+            table(3, StringPairCountingAllocator(counter));
+        fillTableAndEraseEvenKeys(table, 100);
+        table.clear();
+        table.insert(1, "a");
+
+        EXPECT_EQ(&counter, &table.getAllocator().getCounter());
+        EXPECT_EQ(table.getMemoryUsage().arrayBytes, counter.bytes);
+    }
+    EXPECT_EQ(0, counter.bytes);
+}
@@ -0,0 +1,164 @@
+#include "UnorderedTable.h"
+#include "OrderedTable.h"
+
+#include <gtest.h>
+
+
+TEST(TestUnorderedTable, can_find_all_keys_of_large_table) {
+    UnorderedTable<int> table;
+    for (KeyType key = 0; key < 100; key++)
+        table.insert(key * 3, int(key));
+
+    for (KeyType key = 0; key < 100; key++)
+        ASSERT_EQ(int(key), table.find(key * 3)->second);
+    EXPECT_EQ(nullptr, table.find(1));
+}
+
+TEST(TestUnorderedTable, keys_stay_with_their_elements_after_erasing) {
+    UnorderedTable<int> table;
+    for (KeyType key = 0; key < 40; key++)
+        table.insert(key, int(key));
+
+    for (KeyType key = 0; key < 40; key += 3)
+        table.erase(key);
+
+    for (KeyType key = 0; key < 40; key++)
+        if (key % 3 == 0)
+            ASSERT_EQ(nullptr, table.find(key));
+        else
+            ASSERT_EQ(int(key), table.find(key)->second);
+}
+
+TEST(TestUnorderedTable, can_insert_after_clear) {
+    UnorderedTable<int> table;
+    for (KeyType key = 0; key < 40; key++)
+        table.insert(key, int(key));
+
+    table.clear();
+    table.insert(39, 1);
+
+    EXPECT_EQ(1, table.find(39)->second);
+    EXPECT_EQ(nullptr, table.find(0));
+}
+
+
+// gives access to the storage size
+class TestGrowthPolicyTable : public UnorderedTable<int> {
+public:
+
+    TestGrowthPolicyTable(const GrowthPolicy& policy) : UnorderedTable<int>(policy) {}
+
+    size_t getStorageSize() const {
+        return storage.size();
+    }
+};
+
+TEST(TestUnorderedTable, growth_policy_sets_storage_sizes) {
+    GrowthPolicy policy;
+    policy.startStorageSize = 1;
+    policy.growthFactor = 2;
+    TestGrowthPolicyTable table(policy);
+    for (KeyType key = 0; key < 5; key++)
+        table.insert(key, int(key));
+
+    EXPECT_EQ(8, table.getStorageSize());
+    table.clear();
+    EXPECT_EQ(1, table.getStorageSize());
+}
+
+TEST(TestUnorderedTable, storage_grows_at_least_by_one_cell) {
+    GrowthPolicy policy;
+    policy.startStorageSize = 1;
+    TestGrowthPolicyTable table(policy);
+    for (KeyType key = 0; key < 5; key++)
+        table.insert(key, int(key));
+
+    EXPECT_EQ(5, table.getStorageSize());
+    for (KeyType key = 0; key < 5; key++)
+        ASSERT_EQ(int(key), table.find(key)->second);
+}
+
+TEST(TestUnorderedTable, throws_if_growth_factor_is_too_small) {
+    GrowthPolicy policy;
+    policy.growthFactor = 1;
+
+    EXPECT_ANY_THROW(UnorderedTable<int> table(policy));
+    EXPECT_ANY_THROW(OrderedTable<int>().setGrowthPolicy(policy));
+}
+
+class TestSelfOrganizingTable : public UnorderedTable<int>, public testing::Test {
+public:
+
+    TestSelfOrganizingTable() {
+        for (KeyType key = 1; key <= 5; key++)
+            insert(key, int(key));
+    }
+
+    KeyType getKey(size_t index) {
+        return storage[index].first;
+    }
+};
+
+
+TEST_F(TestSelfOrganizingTable, move_to_front_moves_found_element_to_the_beginning) {
+    setPolicy(SelfOrganizingPolicy::MOVE_TO_FRONT);
+
+    EXPECT_EQ(4, find(4)->second);
+
+    EXPECT_EQ(4, getKey(0));
+    EXPECT_EQ(1, getKey(1));
+    EXPECT_EQ(5, getKey(4));
+}
+
+TEST_F(TestSelfOrganizingTable, transpose_swaps_found_element_with_previous_one) {
+    setPolicy(SelfOrganizingPolicy::TRANSPOSE);
+
+    EXPECT_EQ(4, find(4)->second);
+
+    EXPECT_EQ(4, getKey(2));
+    EXPECT_EQ(3, getKey(3));
+}
+
+TEST_F(TestSelfOrganizingTable, count_sorts_elements_by_number_of_searches) {
+    setPolicy(SelfOrganizingPolicy::COUNT);
+
+    find(5);
+    find(5);
+    find(3);
+
+    EXPECT_EQ(5, getKey(0));
+    EXPECT_EQ(3, getKey(1));
+    EXPECT_EQ(1, getKey(2));
+}
+
+TEST_F(TestSelfOrganizingTable, erasing_keeps_order_if_policy_is_set) {
+    setPolicy(SelfOrganizingPolicy::MOVE_TO_FRONT);
+    find(5);
+
+    erase(1);
+
+    EXPECT_EQ(5, getKey(0));
+    EXPECT_EQ(2, getKey(1));
+    EXPECT_EQ(4, getKey(3));
+}
+
+TEST_F(TestSelfOrganizingTable, all_policies_keep_table_correct) {
+    SelfOrganizingPolicy policies[] = { SelfOrganizingPolicy::MOVE_TO_FRONT,
+        SelfOrganizingPolicy::TRANSPOSE, SelfOrganizingPolicy::COUNT };
+    for (SelfOrganizingPolicy policy : policies) {
+        UnorderedTable<int> table(START_STORAGE_SIZE, policy);
+        for (KeyType key = 0; key < 50; key++)
+            table.insert(key, int(key));
+        for (KeyType key = 0; key < 50; key += 7) {
+            table.find(49 - key);
+            table.erase(key);
+        }
+
+        for (KeyType key = 0; key < 50; key++)
+            if (key % 7 == 0)
+                ASSERT_EQ(nullptr, table.find(key));
+            else
+                ASSERT_EQ(int(key), table.find(key)->second);
+        ASSERT_EQ(42, table.getSize());
+    }
+}
@@ -0,0 +1,148 @@
+#include "UnrolledList.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest.h>
+
+
+class TestUnrolledList : public testing::Test {
+public:
+
+    // small chunks, so that splitting and merging are tested on few elements
+    UnrolledList<int, PoolAllocator<int>, 4> list;
+    UnrolledList<int, PoolAllocator<int>, 4> emptyList;
+
+    TestUnrolledList() {
+        for (int i = 1; i <= 6; i++)
+            list.pushBack(i);
+    }
+
+    template <class ListType>
+    std::vector<int> toVector(const ListType& l) {
+        return std::vector<int>(l.begin(), l.end());
+    }
+};
+
+
+TEST_F(TestUnrolledList, can_push_back_and_iterate) {
+    EXPECT_EQ(std::vector<int>({ 1, 2, 3, 4, 5, 6 }), toVector(list));
+}
+
+TEST_F(TestUnrolledList, can_push_front) {
+    for (int i = 1; i <= 6; i++)
+        emptyList.pushFront(i);
+
+    EXPECT_EQ(std::vector<int>({ 6, 5, 4, 3, 2, 1 }), toVector(emptyList));
+}
+
+TEST_F(TestUnrolledList, can_pop_front_and_back) {
+    list.popFront();
+    list.popBack();
+    list.popBack();
+
+    EXPECT_EQ(std::vector<int>({ 2, 3, 4 }), toVector(list));
+}
+
+TEST_F(TestUnrolledList, pop_from_empty_list_does_nothing) {
+    emptyList.popFront();
+    emptyList.popBack();
+
+    EXPECT_TRUE(emptyList.empty());
+}
+
+TEST_F(TestUnrolledList, can_insert_after_with_split_of_full_chunk) {
+    auto it = list.begin();
+    ++it;
+    list.insertAfter(10, it);  // the first chunk {1, 2, 3, 4} is full
+    list.insertAfter(0);
+
+    EXPECT_EQ(std::vector<int>({ 0, 1, 2, 10, 3, 4, 5, 6 }), toVector(list));
+}
+
+TEST_F(TestUnrolledList, can_insert_after_last_element_of_full_chunk) {
+    auto it = list.begin();
+    for (int i = 0; i < 3; i++) ++it;
+    EXPECT_EQ(10, *list.insertAfter(10, it));
+
+    EXPECT_EQ(std::vector<int>({ 1, 2, 3, 4, 10, 5, 6 }), toVector(list));
+}
+
+TEST_F(TestUnrolledList, can_erase_after) {
+    auto it = list.begin();
+    for (int i = 0; i < 3; i++) ++it;
+    list.eraseAfter(it);  // the first element of the next chunk
+    list.eraseAfter();
+
+    EXPECT_EQ(std::vector<int>({ 2, 3, 4, 6 }), toVector(list));
+}
+
+TEST_F(TestUnrolledList, merges_chunks_after_erasing) {
+    list.eraseFirst([](int x) { return x == 2; });
+    list.eraseFirst([](int x) { return x == 3; });
+    list.pushBack(7);  // last chunk {1, 4, 5, 6} is full after merge, so 7 goes to a new chunk
+    list.insertAfter(0);
+
+    EXPECT_EQ(std::vector<int>({ 0, 1, 4, 5, 6, 7 }), toVector(list));
+    EXPECT_EQ(3, list.getAllocator().getPool()->getUsedBlocks());
+}
+
+TEST_F(TestUnrolledList, can_find_first) {
+    int* ptr = list.findFirst([](int x) { return x > 4; });
+
+    ASSERT_NE(nullptr, ptr);
+    EXPECT_EQ(5, *ptr);
+    EXPECT_EQ(nullptr, list.findFirst([](int x) { return x > 10; }));
+}
+
+TEST_F(TestUnrolledList, can_erase_first) {
+    EXPECT_TRUE(list.eraseFirst([](int x) { return x % 2 == 0; }));
+    EXPECT_FALSE(list.eraseFirst([](int x) { return x > 10; }));
+
+    EXPECT_EQ(std::vector<int>({ 1, 3, 4, 5, 6 }), toVector(list));
+}
+
+TEST_F(TestUnrolledList, can_copy_list) {
+    UnrolledList<int, PoolAllocator<int>, 4> list2(list);
+    EXPECT_EQ(list, list2);
+
+    list2.popFront();
+    EXPECT_NE(list, list2);
+}
+
+TEST_F(TestUnrolledList, can_assign_list) {
+    emptyList.pushBack(10);
+    emptyList = list;
+
+    EXPECT_EQ(list, emptyList);
+}
+
+TEST_F(TestUnrolledList, can_clear_list) {
+    list.clear();
+
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.begin(), list.end());
+    list.pushBack(1);
+    EXPECT_EQ(std::vector<int>({ 1 }), toVector(list));
+}
+
+TEST_F(TestUnrolledList, size_is_counted) {
+    list.pushFront(0);
+    list.insertAfter(10, list.begin());
+    list.eraseAfter(list.begin());
+    list.popBack();
+
+    EXPECT_EQ(6, list.getSize());
+    list.clear();
+    EXPECT_EQ(0, list.getSize());
+}
+
+TEST_F(TestUnrolledList, works_with_std_allocator) {
+    UnrolledList<std::string, std::allocator<std::string>> strings;
+    for (int i = 0; i < 100; i++)
+        strings.pushBack(std::to_string(i));
+    strings.eraseFirst([](const std::string& s) { return s == "50"; });
+
+    EXPECT_EQ(nullptr, strings.findFirst([](const std::string& s) { return s == "50"; }));
+    EXPECT_EQ("99", *strings.findFirst([](const std::string& s) { return s == "99"; }));
+}
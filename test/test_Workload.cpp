@@ -0,0 +1,154 @@
+#include "Workload.h"
+#include "HashTableSeparateChaining.h"
+
+#include <set>
+#include <vector>
+
+#include <gtest.h>
+
+
+size_t countOperations(const std::vector<Operation>& operations, OperationType type) {
+    size_t count = 0;
+    for (const Operation& operation : operations)
+        count += operation.type == type;
+    return count;
+}
+
+
+TEST(TestWorkload, same_seed_gives_same_operations) {
+    std::vector<Operation> operations1 = WorkloadGenerator(getYcsbWorkload('A')).generate();
+    std::vector<Operation> operations2 = WorkloadGenerator(getYcsbWorkload('A')).generate();
+
+    for (size_t i = 0; i < operations1.size(); i++) {
+        ASSERT_EQ(operations1[i].type, operations2[i].type);
+        ASSERT_EQ(operations1[i].key, operations2[i].key);
+    }
+}
+
+TEST(TestWorkload, different_seeds_give_different_operations) {
+    WorkloadSpec spec = getYcsbWorkload('A');
+    std::vector<Operation> operations1 = WorkloadGenerator(spec).generate();
+    spec.seed = 2;
+    std::vector<Operation> operations2 = WorkloadGenerator(spec).generate();
+
+    size_t differentKeys = 0;
+    for (size_t i = 0; i < operations1.size(); i++)
+        differentKeys += operations1[i].key != operations2[i].key;
+    EXPECT_GT(differentKeys, operations1.size() / 2);
+}
+
+TEST(TestWorkload, keys_of_records_are_distinct) {
+    std::vector<KeyType> keys = WorkloadGenerator(getYcsbWorkload('C', 10000)).getLoadKeys();
+
+    EXPECT_EQ(10000, std::set<KeyType>(keys.begin(), keys.end()).size());
+}
+
+TEST(TestWorkload, operations_have_given_proportions) {
+    std::vector<Operation> operations = WorkloadGenerator(getYcsbWorkload('B', 1000, 100000)).generate();
+
+    size_t updates = countOperations(operations, OperationType::UPDATE);
+    EXPECT_NEAR(5000, updates, 500);
+    EXPECT_EQ(operations.size(), updates + countOperations(operations, OperationType::READ));
+}
+
+TEST(TestWorkload, zipfian_chooser_prefers_the_oldest_records) {
+    std::vector<Operation> operations = WorkloadGenerator(getYcsbWorkload('C', 1000, 10000)).generate();
+
+    size_t firstRecords = 0;
+    for (const Operation& operation : operations)
+        firstRecords += operation.record < 10;
+    EXPECT_GT(firstRecords, operations.size() / 4);  // 1% of records get more than 25% of operations
+}
+
+TEST(TestWorkload, latest_chooser_prefers_inserted_records) {
+    std::vector<Operation> operations = WorkloadGenerator(getYcsbWorkload('D', 1000, 10000)).generate();
+
+    size_t lastRecords = 0, reads = 0;
+    uint64_t endRecord = 1000;
+    for (const Operation& operation : operations) {
+        if (operation.type == OperationType::INSERT) {
+            ASSERT_EQ(endRecord, operation.record);
+            endRecord++;
+        }
+        else {
+            ASSERT_LT(operation.record, endRecord);
+            lastRecords += operation.record + 10 >= endRecord;
+            reads++;
+        }
+    }
+    EXPECT_GT(lastRecords, reads / 4);
+}
+
+TEST(TestWorkload, hotspot_chooser_uses_hot_set) {
+    WorkloadSpec spec = getYcsbWorkload('C', 1000, 10000);
+    spec.keyChooser = KeyChooserType::HOTSPOT;
+    spec.hotSetFraction = 0.1;
+    spec.hotOperationFraction = 0.9;
+    std::vector<Operation> operations = WorkloadGenerator(spec).generate();
+
+    size_t hotOperations = 0;
+    for (const Operation& operation : operations)
+        hotOperations += operation.record < 100;
+    EXPECT_NEAR(9000, hotOperations, 300);
+}
+
+TEST(TestWorkload, scans_dont_go_beyond_the_last_record) {
+    std::vector<Operation> operations = WorkloadGenerator(getYcsbWorkload('E', 100, 1000)).generate();
+
+    uint64_t endRecord = 100;
+    for (const Operation& operation : operations)
+        if (operation.type == OperationType::INSERT)
+            endRecord++;
+        else {
+            ASSERT_EQ(OperationType::SCAN, operation.type);
+            ASSERT_GE(operation.scanLength, 1);
+            ASSERT_LE(operation.record + operation.scanLength, endRecord);
+        }
+}
+
+TEST(TestWorkload, throws_if_workload_is_unknown) {
+    ASSERT_ANY_THROW(getYcsbWorkload('G'));
+}
+
+TEST(TestWorkload, all_operations_of_ycsb_workloads_succeed) {
+    for (char name : { 'A', 'B', 'C', 'D', 'E', 'F' }) {
+        WorkloadGenerator generator(getYcsbWorkload(name, 1000, 5000));
+        HashTableSeparateChaining<int> table;
+        loadWorkload(table, generator);
+        std::vector<Operation> operations = generator.generate();
+
+        WorkloadResult result = runWorkload(table, operations);
+
+        EXPECT_EQ(operations.size(), result.succeeded) << name;
+        EXPECT_EQ(generator.getRecordCount(), table.getSize()) << name;
+        ASSERT_EQ(operations.size(), result.latenciesNs.size());
+    }
+}
+
+TEST(TestWorkload, delete_churn_keeps_the_number_of_records) {
+    WorkloadGenerator generator(getDeleteChurnWorkload(1000, 20000));
+    TableAdapter<HashTableSeparateChaining<int>> adapter;
+    TableInterface<int>& table = adapter;
+    loadWorkload(table, generator);
+    std::vector<Operation> operations = generator.generate();
+
+    WorkloadResult result = runWorkload(table, operations, false);
+
+    EXPECT_EQ(operations.size(), result.succeeded);
+    EXPECT_EQ(generator.getRecordCount(), table.getSize());
+    EXPECT_NEAR(1000, table.getSize(), 300);
+    EXPECT_TRUE(result.latenciesNs.empty());
+}
+
+TEST(TestWorkload, insert_ramp_grows_table) {
+    WorkloadGenerator generator(getInsertRampWorkload(100, 10000));
+    HashTableSeparateChaining<int> table;
+    loadWorkload(table, generator);
+    std::vector<Operation> operations = generator.generate();
+
+    WorkloadResult result = runWorkload(table, operations);
+
+    EXPECT_EQ(100 + countOperations(operations, OperationType::INSERT), table.getSize());
+    EXPECT_EQ(countOperations(operations, OperationType::READ),
+        result.getLatencies(operations, OperationType::READ).size());
+}
@@ -2,16 +2,32 @@
 #include "UnorderedTable.h"
 #include "HashTableOpenAddressing.h"
 #include "HashTableSeparateChaining.h"
+#include "AdaptiveRadixTree.h"
+#include "DirectAddressTable.h"
 
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include <gtest.h>
 
 
+template <class ElemType>
+using HashTableUnrolledChaining = HashTableSeparateChaining<ElemType, UnrolledList<std::pair<KeyType, ElemType>>>;
+
+template <class ElemType>
+using HashTableSmallVectorChaining = HashTableSeparateChaining<ElemType, SmallVectorBucket<std::pair<KeyType, ElemType>>>;
+
+template <class ElemType>
+using HashTableCachedHashOpenAddressing = HashTableOpenAddressing<ElemType, HashedPair<ElemType>>;
+
+template <class ElemType>
+using HashTableCachedHashChaining = HashTableSeparateChaining<ElemType, List<HashedPair<ElemType>>>;
+
 // macro to run a test for all types of search tables
 // defines name "TableType" as a type of a table inside of the test body
 #define TEST_FOR_ALL_TABLES(test_case, test_name)                                    \
-template <template<class> class TableType> void func##test_case##test_name();        \
+template <template<class...> class TableType> void func##test_case##test_name();        \
 TEST(test_case##UnorderedTable, test_name) {                                         \
     func##test_case##test_name<UnorderedTable>();                                    \
 }                                                                                    \
@@ -24,7 +40,25 @@ TEST(test_case##HashTableOpenAddressing, test_name) {
 TEST(test_case##HashTableSeparateChaining, test_name) {                              \
     func##test_case##test_name<HashTableSeparateChaining>();                         \
 }                                                                                    \
-template <template<class> class TableType>                                           \
+TEST(test_case##HashTableUnrolledChaining, test_name) {                              \
+    func##test_case##test_name<HashTableUnrolledChaining>();                         \
+}                                                                                    \
+TEST(test_case##HashTableSmallVectorChaining, test_name) {                           \
+    func##test_case##test_name<HashTableSmallVectorChaining>();                      \
+}                                                                                    \
+TEST(test_case##HashTableCachedHashOpenAddressing, test_name) {                      \
+    func##test_case##test_name<HashTableCachedHashOpenAddressing>();                 \
+}                                                                                    \
+TEST(test_case##HashTableCachedHashChaining, test_name) {                            \
+    func##test_case##test_name<HashTableCachedHashChaining>();                       \
+}                                                                                    \
+TEST(test_case##AdaptiveRadixTree, test_name) {                                      \
+    func##test_case##test_name<AdaptiveRadixTree>();                                 \
+}                                                                                    \
+TEST(test_case##DirectAddressTable, test_name) {                                     \
+    func##test_case##test_name<DirectAddressTable>();                                \
+}                                                                                    \
+template <template<class...> class TableType>                                           \
 void func##test_case##test_name()
 
 
@@ -137,4 +171,148 @@ TEST_FOR_ALL_TABLES(TestCommon, can_insert_and_erase_complex_test) {
     table.erase(15);
 
     ASSERT_TRUE(table.isEmpty());
-}
\ No newline at end of file
+}
+TEST_FOR_ALL_TABLES(TestCommon, find_or_insert_inserts_new_element) {
+    TableType<std::string> table;
+    table.insert(1, "a");
+
+    auto res = table.findOrInsert(2, "b");
+
+    ASSERT_TRUE(res.second);
+    ASSERT_EQ(table.find(2), res.first);
+    ASSERT_EQ("b", res.first->second);
+    ASSERT_EQ(2, table.getSize());
+}
+
+TEST_FOR_ALL_TABLES(TestCommon, find_or_insert_finds_existing_element) {
+    TableType<std::string> table;
+    table.insert(1, "a");
+
+    auto res = table.findOrInsert(1, "b");
+
+    ASSERT_FALSE(res.second);
+    ASSERT_EQ("a", res.first->second);
+    ASSERT_EQ(1, table.getSize());
+}
+
+TEST_FOR_ALL_TABLES(TestCommon, get_or_insert_inserts_default_element) {
+    TableType<std::string> table;
+
+    table.getOrInsert(3) += "c";
+    table.getOrInsert(3) += "c";
+
+    ASSERT_EQ("cc", table.find(3)->second);
+    ASSERT_EQ(1, table.getSize());
+}
+
+TEST_FOR_ALL_TABLES(TestCommon, upsert_replaces_existing_element) {
+    TableType<std::string> table;
+
+    ASSERT_TRUE(table.upsert(1, "a"));
+    ASSERT_FALSE(table.upsert(1, "b"));
+
+    ASSERT_EQ("b", table.find(1)->second);
+    ASSERT_EQ(1, table.getSize());
+}
+
+TEST_FOR_ALL_TABLES(TestCommon, update_can_count_keys) {
+    TableType<int> table;
+    std::vector<KeyType> keys = { 5, 1, 5, 100, 5, 1, 3000 };
+
+    for (KeyType key : keys)
+        table.update(key, [](int& count) { count++; });
+
+    ASSERT_EQ(4, table.getSize());
+    ASSERT_EQ(3, table.find(5)->second);
+    ASSERT_EQ(2, table.find(1)->second);
+    ASSERT_EQ(1, table.find(100)->second);
+    ASSERT_EQ(1, table.find(3000)->second);
+}
+
+TEST_FOR_ALL_TABLES(TestCommon, find_or_insert_complex_test) {
+    TableType<int> table;
+    for (int i = 0; i < 200; i++)
+        table.insert(KeyType(i * 7), i);
+    for (int i = 0; i < 200; i += 2)
+        table.erase(KeyType(i * 7));
+
+    for (int i = 0; i < 400; i++) {
+        auto res = table.findOrInsert(KeyType(i * 7), -i);
+        ASSERT_EQ(i >= 200 || i % 2 == 0, res.second);
+        ASSERT_EQ(KeyType(i * 7), res.first->first);
+    }
+
+    ASSERT_EQ(400, table.getSize());
+    for (int i = 0; i < 400; i++)
+        ASSERT_EQ(i >= 200 || i % 2 == 0 ? -i : i, table.find(KeyType(i * 7))->second);
+}
+
+TEST_FOR_ALL_TABLES(TestCommon, table_has_no_virtual_functions) {
+    ASSERT_FALSE(std::is_polymorphic<TableType<std::string>>::value);
+}
+
+TEST_FOR_ALL_TABLES(TestCommon, can_use_table_by_table_interface) {
+    TableAdapter<TableType<std::string>> adapter;
+    TableInterface<std::string>& table = adapter;
+
+    ASSERT_TRUE(table.insert(1, "a"));
+    ASSERT_TRUE(table.upsert(2, "b"));
+    table.getOrInsert(3) = "c";
+    ASSERT_TRUE(table.erase(1));
+
+    ASSERT_EQ(nullptr, table.find(1));
+    ASSERT_EQ("b", table.find(2)->second);
+    ASSERT_EQ("c", adapter.getTable().find(3)->second);
+    ASSERT_EQ(2, table.getSize());
+    table.clear();
+    ASSERT_TRUE(table.isEmpty());
+}
+
+// a non-const adapter is copied by the copy constructor, it is not passed to the constructor of the table
+TEST(TestTableAdapter, can_copy_adapter) {
+    TableAdapter<HashTableOpenAddressing<std::string>> adapter;
+    adapter.insert(1, "a");
+
+    TableAdapter<HashTableOpenAddressing<std::string>> copy(adapter);
+    copy.insert(2, "b");
+
+    ASSERT_EQ("a", copy.find(1)->second);
+    ASSERT_EQ(2, copy.getSize());
+    ASSERT_EQ(1, adapter.getSize());
+}
+
+TEST_FOR_ALL_TABLES(TestCommon, memory_usage_is_split_into_elements_metadata_and_slack) {
+    TableType<std::string> table;
+    for (KeyType key = 0; key < 500; key++)
+        table.insert(key, std::string(100, 'a'));
+    for (KeyType key = 0; key < 100; key++)
+        table.erase(key);
+
+    MemoryUsage usage = table.getMemoryUsage();
+
+    ASSERT_EQ(400 * sizeof(std::pair<KeyType, std::string>), usage.elementBytes);
+    ASSERT_EQ(usage.arrayBytes + usage.nodeBytes, usage.elementBytes + usage.metadataBytes + usage.slackBytes);
+    ASSERT_GE(usage.elementHeapBytes, 400 * 100);
+    ASSERT_LE(usage.elementHeapBytes, 400 * 200);
+}
+
+typedef std::basic_string<char, std::char_traits<char>, CountingAllocator<char>> CountedString;
+
+TEST_FOR_ALL_TABLES(TestCommon, heap_memory_of_elements_is_equal_to_allocated_one) {
+    AllocationCounter counter;
+    {
+        TableType<CountedString> table;
+        CountedString value(100, 'a', CountingAllocator<char>(counter));
+        for (KeyType key = 0; key < 100; key++)
+            table.insert(key, value);
+
+        ASSERT_EQ(counter.bytes - getHeapBytes(value), table.getMemoryUsage().elementHeapBytes);
+
+        // erased elements can keep their memory till the next repack, then it is counted too
+        for (KeyType key = 0; key < 100; key += 2)
+            table.erase(key);
+        ASSERT_EQ(counter.bytes - getHeapBytes(value), table.getMemoryUsage().elementHeapBytes);
+    }
+    ASSERT_EQ(0, counter.bytes);  // there are no leaks
+    ASSERT_EQ(counter.allocations, counter.deallocations);
+}